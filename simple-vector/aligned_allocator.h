@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Аллокатор, выравнивающий начало каждого блока по границе Alignment байт (степень двойки,
+// не меньше alignof(Type)): 32 или 64 для векторных загрузок AVX и строк кэша, 4096 для страниц.
+// Память выделяется выравнивающим operator new. reallocate не предоставляется: ArrayPtr переносит
+// тривиально перемещаемые элементы в новый выровненный блок побайтовым копированием
+template <typename Type, size_t Alignment>
+class AlignedAllocator {
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(Type), "Alignment must not be weaker than alignof(Type)");
+
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    // Гарантированное выравнивание начала блока
+    static constexpr size_t alignment = Alignment;
+
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, (Alignment > alignof(Other) ? Alignment : alignof(Other))>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other, size_t OtherAlignment>
+    AlignedAllocator(const AlignedAllocator<Other, OtherAlignment>&) noexcept {
+    }
+
+    // Выделяет неинициализированную память под n элементов, выровненную по Alignment
+    [[nodiscard]] Type* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(::operator new(n * sizeof(Type), std::align_val_t{ Alignment }));
+    }
+
+    // Освобождает память, выделенную через allocate
+    void deallocate(Type* p, size_t) noexcept {
+        ::operator delete(static_cast<void*>(p), std::align_val_t{ Alignment });
+    }
+};
+
+template <typename Type, size_t Alignment, typename Other, size_t OtherAlignment>
+inline bool operator==(const AlignedAllocator<Type, Alignment>&, const AlignedAllocator<Other, OtherAlignment>&) noexcept {
+    return Alignment == OtherAlignment;
+}
+
+template <typename Type, size_t Alignment, typename Other, size_t OtherAlignment>
+inline bool operator!=(const AlignedAllocator<Type, Alignment>&, const AlignedAllocator<Other, OtherAlignment>&) noexcept {
+    return Alignment != OtherAlignment;
+}
+
+namespace detail {
+
+    // Выравнивание начала блоков, которое гарантирует аллокатор: Allocator::alignment,
+    // если аллокатор его объявляет, иначе alignof элемента
+    template <typename Allocator, typename = void>
+    inline constexpr size_t kAllocatorAlignment = alignof(typename Allocator::value_type);
+
+    template <typename Allocator>
+    inline constexpr size_t kAllocatorAlignment<Allocator, std::void_t<decltype(Allocator::alignment)>> = Allocator::alignment;
+
+    // Сообщает, выровнен ли p по границе alignment байт
+    inline bool IsAlignedPointer(const void* p, size_t alignment) noexcept {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    }
+
+    // Возвращает p, сообщая компилятору, что он выровнен по границе Alignment байт
+    template <size_t Alignment, typename Type>
+    Type* AssumeAligned(Type* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<Type*>(__builtin_assume_aligned(p, Alignment));
+#else
+        return p;
+#endif
+    }
+
+}
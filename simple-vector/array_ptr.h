@@ -3,75 +3,205 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
-template <typename Type>
+#include "constexpr_support.h"
+#include "instrumentation.h"
+#include "malloc_allocator.h"
+#include "relocation.h"
+
+namespace detail {
+
+    // Проверяет, предоставляет ли аллокатор нестандартный метод reallocate(p, old_n, new_n)
+    template <typename Allocator, typename = void>
+    struct HasReallocate : std::false_type {
+    };
+
+    template <typename Allocator>
+    struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+        std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>> : std::true_type {
+    };
+
+}
+
+// RAII-обертка над неинициализированным массивом в динамической памяти, выделенной аллокатором Allocator.
+// ArrayPtr только выделяет и освобождает память, но не создает и не разрушает элементы:
+// временем жизни объектов в массиве управляет владелец (например, SimpleVector).
+// В константных выражениях (C++20) память выделяется через std::allocator независимо от Allocator,
+// так как malloc в них недоступен; такая память не может пережить вычисление выражения
+template <typename Type, typename Allocator = MallocAllocator<Type>>
 class ArrayPtr {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocatorTraits::value_type, Type>, "Allocator::value_type must be Type");
+    static_assert(std::is_same_v<typename AllocatorTraits::pointer, Type*>, "fancy pointers are not supported");
+
 public:
     ArrayPtr() = default;
 
-    // Создает массив из size элементов, инициализированных значением по умолчанию
-    explicit ArrayPtr(size_t size) {
-        if (size != 0) {
-            raw_ptr_ = new Type[size]();
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(const Allocator& alloc) noexcept : alloc_(alloc) {
+    }
+
+    // Выделяет неинициализированную память под capacity элементов
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(size_t capacity, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+        if (capacity != 0) {
+            raw_ptr_ = Allocate_(capacity);
+            capacity_ = capacity;
+            detail::RecordVectorEvent<Type>(VectorEvent::kAllocation, capacity);
         }
     }
 
-    // Конструктор из сырого указателя, хранящего адрес массива
-    explicit ArrayPtr(Type* raw_ptr) noexcept : raw_ptr_(raw_ptr) {
+    // Принимает во владение память под capacity элементов, выделенную аллокатором alloc
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(Type* raw_ptr, size_t capacity, const Allocator& alloc = Allocator()) noexcept
+        : alloc_(alloc), raw_ptr_(raw_ptr), capacity_(raw_ptr ? capacity : 0) {
     }
 
     ArrayPtr(const ArrayPtr&) = delete;
     ArrayPtr& operator=(const ArrayPtr&) = delete;
 
-    ArrayPtr(ArrayPtr&& other) noexcept {
-        std::swap(raw_ptr_, other.raw_ptr_);
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(ArrayPtr&& other) noexcept
+        : alloc_(std::move(other.alloc_))
+        , raw_ptr_(std::exchange(other.raw_ptr_, nullptr))
+        , capacity_(std::exchange(other.capacity_, 0)) {
     }
 
-    ArrayPtr& operator=(ArrayPtr&& rhs) noexcept {
-        delete[] raw_ptr_;
-        raw_ptr_ = rhs.raw_ptr_;
-        rhs.raw_ptr_ = nullptr;
+    // Аллокатор перенимается, только если он распространяется при перемещающем присваивании.
+    // Иначе аллокаторы обоих объектов должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr& operator=(ArrayPtr&& rhs) noexcept {
+        if (this != &rhs) {
+            Deallocate();
+            if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(rhs.alloc_);
+            }
+            else {
+                assert(alloc_ == rhs.alloc_);
+            }
+            raw_ptr_ = std::exchange(rhs.raw_ptr_, nullptr);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+        }
         return *this;
     }
 
-    ~ArrayPtr() {
-        delete[] raw_ptr_;
+    SIMPLE_VECTOR_CONSTEXPR ~ArrayPtr() {
+        Deallocate();
+    }
+
+    // Заменяет массив и аллокатор массивом и аллокатором other независимо от правил распространения аллокатора.
+    // Требует, чтобы аллокатор поддерживал присваивание
+    SIMPLE_VECTOR_CONSTEXPR void Adopt(ArrayPtr&& other) noexcept {
+        if (this != &other) {
+            Deallocate();
+            alloc_ = std::move(other.alloc_);
+            raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
     }
 
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
-    [[nodiscard]] Type* Release() noexcept {
-        Type* p = raw_ptr_;
-        raw_ptr_ = nullptr;
-        return p;
+    [[nodiscard]] SIMPLE_VECTOR_CONSTEXPR Type* Release() noexcept {
+        capacity_ = 0;
+        return std::exchange(raw_ptr_, nullptr);
     }
 
     // Возвращает ссылку на элемент массива с индексом index
-    Type& operator[](size_t index) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
         assert(raw_ptr_);
         return raw_ptr_[index];
     }
 
     // Возвращает константную ссылку на элемент массива с индексом index
-    const Type& operator[](size_t index) const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
         assert(raw_ptr_);
         return raw_ptr_[index];
     }
 
     // Возвращает true, если указатель ненулевой, и false в противном случае
-    explicit operator bool() const {
+    SIMPLE_VECTOR_CONSTEXPR explicit operator bool() const {
         return raw_ptr_;
     }
 
     // Возвращает значение сырого указателя, хранящего адрес начала массива
-    Type* Get() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type* Get() const noexcept {
         return raw_ptr_;
     }
 
-    // Обменивается значениям указателя на массив с объектом other
-    void swap(ArrayPtr& other) noexcept {
+    // Возвращает количество элементов, под которые выделена память
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Возвращает копию аллокатора
+    SIMPLE_VECTOR_CONSTEXPR Allocator GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Изменяет размер массива до new_capacity элементов, сохраняя первые size элементов.
+    // Доступно только для тривиально перемещаемых типов. Если аллокатор предоставляет reallocate
+    // (как MallocAllocator), память по возможности расширяется на месте, иначе элементы переносятся
+    // в новый блок побайтовым копированием
+    SIMPLE_VECTOR_CONSTEXPR void Reallocate(size_t new_capacity, size_t size) {
+        static_assert(IsTriviallyRelocatableV<Type>, "Type must be trivially relocatable");
+        assert(size <= capacity_ && size <= new_capacity);
+
+        if (new_capacity == 0) {
+            Deallocate();
+            raw_ptr_ = nullptr;
+            capacity_ = 0;
+            return;
+        }
+
+        if constexpr (detail::HasReallocate<Allocator>::value) {
+            if (!detail::IsConstantEvaluated()) {
+                raw_ptr_ = alloc_.reallocate(raw_ptr_, capacity_, new_capacity);
+                capacity_ = new_capacity;
+                detail::RecordVectorEvent<Type>(VectorEvent::kAllocation, new_capacity);
+                return;
+            }
+        }
+        Type* p = Allocate_(new_capacity);
+        UninitializedRelocate(raw_ptr_, raw_ptr_ + size, p);
+        Deallocate();
+        raw_ptr_ = p;
+        capacity_ = new_capacity;
+        detail::RecordVectorEvent<Type>(VectorEvent::kAllocation, new_capacity);
+    }
+
+    // Обменивается значениям указателя на массив с объектом other.
+    // Аллокаторы обмениваются, только если они распространяются при обмене. Иначе они должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR void swap(ArrayPtr& other) noexcept {
+        if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        }
+        else {
+            assert(alloc_ == other.alloc_);
+        }
         std::swap(raw_ptr_, other.raw_ptr_);
+        std::swap(capacity_, other.capacity_);
     }
 
 private:
+    [[no_unique_address]] Allocator alloc_;
     Type* raw_ptr_ = nullptr;
+    size_t capacity_ = 0;
+
+    SIMPLE_VECTOR_CONSTEXPR Type* Allocate_(size_t capacity) {
+        if (detail::IsConstantEvaluated()) {
+            return std::allocator<Type>().allocate(capacity);
+        }
+        return AllocatorTraits::allocate(alloc_, capacity);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Deallocate() noexcept {
+        if (raw_ptr_) {
+            if (detail::IsConstantEvaluated()) {
+                std::allocator<Type>().deallocate(raw_ptr_, capacity_);
+            }
+            else {
+                AllocatorTraits::deallocate(alloc_, raw_ptr_, capacity_);
+            }
+        }
+    }
 };
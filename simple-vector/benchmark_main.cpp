@@ -0,0 +1,32 @@
+#include <cstring>
+#include <iostream>
+
+#include "benchmarks.h"
+
+// С аргументом --json выполняет только сравнение с std::vector и печатает его результаты в формате JSON
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--json") == 0) {
+        benchmarks::Suite(std::cout);
+        return 0;
+    }
+
+    benchmarks::ConstructorCalls();
+    benchmarks::Relocation();
+    benchmarks::SmallVectorAllocations();
+    benchmarks::BulkInsert();
+    benchmarks::EraseIf();
+    benchmarks::GrowthFootprint();
+    benchmarks::MmapGrowth();
+    benchmarks::Compare();
+    benchmarks::ParallelScaling();
+    benchmarks::ConcurrentAppend();
+    benchmarks::AppendLatency();
+    benchmarks::MappedLoad();
+    benchmarks::Serialization();
+    benchmarks::StructureOfArrays();
+    benchmarks::AlignedKernels();
+    benchmarks::Instrumentation();
+    benchmarks::OverwriteGrowth();
+    benchmarks::SortedContainers();
+    benchmarks::BitVectorOps();
+}
@@ -0,0 +1,1381 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "benchmarks.h"
+#include "bit_vector.h"
+#include "concurrent_simple_vector.h"
+#include "flat_map.h"
+#include "mapped_simple_vector.h"
+#include "mmap_allocator.h"
+#include "segmented_vector.h"
+#include "serialization.h"
+#include "simple_vector.h"
+#include "small_simple_vector.h"
+#include "soa_vector.h"
+#include "tests.h"
+
+namespace benchmarks {
+
+    namespace detail {
+
+        // Крупная структура, подсчитывающая вызовы конструкторов
+        struct Heavy {
+            Heavy() {
+                ++constructed;
+            }
+
+            Heavy(const Heavy&) {
+                ++constructed;
+            }
+
+            Heavy(Heavy&&) noexcept {
+                ++constructed;
+            }
+
+            Heavy& operator=(const Heavy&) = default;
+            Heavy& operator=(Heavy&&) noexcept = default;
+
+            static inline size_t constructed = 0;
+
+            char payload[64] = {};
+        };
+
+        // Тривиально копируемая запись фиксированного размера
+        struct Record {
+            char payload[64];
+        };
+
+        // Запись из восьми 8-байтовых полей, из которых горячий цикл читает одно
+        struct Trade {
+            double price;
+            int64_t quantity;
+            int64_t fields[6];
+        };
+
+        // Владеющий тип, объявленный тривиально перемещаемым
+        struct Owner {
+            std::unique_ptr<int> value;
+        };
+
+        // Не дает компилятору удалить вычисления, результат которых доступен по указателю p
+        inline void DoNotOptimize(const void* p) {
+#if defined(__GNUC__)
+            asm volatile("" : : "g"(p) : "memory");
+#else
+            static const void* volatile sink;
+            sink = p;
+#endif
+        }
+
+        inline size_t allocations = 0;
+
+        // Аллокатор, подсчитывающий выделения и перераспределения памяти
+        template <typename Type>
+        struct CountingAllocator : MallocAllocator<Type> {
+            CountingAllocator() noexcept = default;
+
+            template <typename Other>
+            CountingAllocator(const CountingAllocator<Other>&) noexcept {
+            }
+
+            Type* allocate(size_t n) {
+                ++allocations;
+                return MallocAllocator<Type>::allocate(n);
+            }
+
+            Type* reallocate(Type* p, size_t old_n, size_t new_n) {
+                ++allocations;
+                return MallocAllocator<Type>::reallocate(p, old_n, new_n);
+            }
+        };
+
+        // Заполняет count коротких векторов длиной от 0 до 8 элементов
+        template <typename Vector>
+        void FillShortVectors(size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                Vector v;
+                for (size_t j = 0; j < i % 9; ++j) {
+                    v.PushBack(static_cast<int>(j));
+                }
+                DoNotOptimize(v.begin());
+            }
+        }
+
+#if SIMPLE_VECTOR_X86_SIMD
+        // y += a * x блоками по 8 элементов выровненными загрузками и записями AVX.
+        // blocks * 8 может выходить за размер векторов в пределах их дополненной вместимости
+        __attribute__((target("avx2"))) inline void SaxpyAligned(float a, const float* x, float* y, size_t blocks) {
+            const __m256 factor = _mm256_set1_ps(a);
+            for (size_t i = 0; i < blocks * 8; i += 8) {
+                const __m256 product = _mm256_mul_ps(factor, _mm256_load_ps(x + i));
+                _mm256_store_ps(y + i, _mm256_add_ps(_mm256_load_ps(y + i), product));
+            }
+        }
+
+        // y += a * x невыровненными загрузками AVX со скалярным хвостом
+        __attribute__((target("avx2"))) inline void SaxpyUnaligned(float a, const float* x, float* y, size_t n) {
+            const __m256 factor = _mm256_set1_ps(a);
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m256 product = _mm256_mul_ps(factor, _mm256_loadu_ps(x + i));
+                _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), product));
+            }
+            for (; i < n; ++i) {
+                y[i] += a * x[i];
+            }
+        }
+#endif
+
+        // Возвращает время выполнения сценария в миллисекундах
+        template <typename Scenario>
+        double MeasureMs(Scenario scenario) {
+            const auto start = std::chrono::steady_clock::now();
+            scenario();
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            return elapsed.count();
+        }
+
+        template <typename Type>
+        void ReportPushBack(const std::string& name, size_t size) {
+            using namespace std::string_literals;
+            const double simple = MeasureMs([size] {
+                SimpleVector<Type> v;
+                for (size_t i = 0; i < size; ++i) {
+                    v.PushBack(Type{});
+                }
+                DoNotOptimize(v.begin());
+            });
+            const double standard = MeasureMs([size] {
+                std::vector<Type> v;
+                for (size_t i = 0; i < size; ++i) {
+                    v.push_back(Type{});
+                }
+                DoNotOptimize(v.data());
+            });
+            std::cout << name << ": size="s << size << ", SimpleVector="s << simple << " ms, std::vector="s << standard << " ms"s << std::endl;
+        }
+
+        // Возвращает число конструкторов Heavy, вызванных сценарием
+        template <typename Scenario>
+        size_t CountConstructions(Scenario scenario) {
+            Heavy::constructed = 0;
+            scenario();
+            return Heavy::constructed;
+        }
+
+        // Возвращает размер блока, фактически выделенного malloc, или bytes, если он недоступен
+        inline size_t UsableSize(const void* p, [[maybe_unused]] size_t bytes) {
+#if defined(__GLIBC__)
+            return p ? malloc_usable_size(const_cast<void*>(p)) : 0;
+#else
+            return p ? bytes : 0;
+#endif
+        }
+
+        // Заполняет набор векторов с политикой роста Policy пачками добавлений разной длины
+        // и печатает занятую память до и после ShrinkToFit
+        template <typename Policy>
+        void ReportFootprint(const std::string& name, size_t vector_count) {
+            using namespace std::string_literals;
+            using Vector = SimpleVector<Record, CountingAllocator<Record>, Policy>;
+
+            // Суммарная память векторов: полезная, по вместимости и по размеру блоков malloc
+            const auto footprint = [](const std::vector<Vector>& vectors) {
+                size_t used = 0;
+                size_t capacity = 0;
+                size_t usable = 0;
+                for (const Vector& v : vectors) {
+                    used += v.GetSize() * sizeof(Record);
+                    capacity += v.GetCapacity() * sizeof(Record);
+                    usable += UsableSize(v.begin(), v.GetCapacity() * sizeof(Record));
+                }
+                return std::vector<size_t>{ used, capacity, usable };
+            };
+
+            std::vector<Vector> vectors(vector_count);
+            allocations = 0;
+            const double ms = MeasureMs([&vectors] {
+                for (size_t i = 0; i < vectors.size(); ++i) {
+                    const size_t burst = i * 7919 % 1000 + 1;
+                    for (size_t j = 0; j < burst; ++j) {
+                        vectors[i].PushBack(Record{});
+                    }
+                }
+            });
+            const size_t growth_allocations = allocations;
+            const auto grown = footprint(vectors);
+            for (Vector& v : vectors) {
+                v.ShrinkToFit();
+            }
+            const auto shrunk = footprint(vectors);
+
+            constexpr double kMiB = 1024.0 * 1024.0;
+            std::cout << name << ": "s << ms << " ms, "s << growth_allocations << " allocations, used="s << grown[0] / kMiB
+                << " MiB, capacity="s << grown[1] / kMiB << " MiB, malloc blocks="s << grown[2] / kMiB
+                << " MiB, after ShrinkToFit="s << shrunk[2] / kMiB << " MiB"s << std::endl;
+        }
+
+        // Сбрасывает пиковый размер резидентной памяти процесса (Linux)
+        inline void ResetPeakRss() {
+            std::ofstream("/proc/self/clear_refs") << "5";
+        }
+
+        // Возвращает пиковый размер резидентной памяти процесса в килобайтах или 0, если он недоступен
+        inline size_t PeakRssKiB() {
+            std::ifstream status("/proc/self/status");
+            for (std::string line; std::getline(status, line);) {
+                if (line.rfind("VmHWM:", 0) == 0) {
+                    return std::stoul(line.substr(6));
+                }
+            }
+            return 0;
+        }
+
+        // Возвращает пиковый размер резидентной памяти процесса в мегабайтах или 0, если он недоступен
+        inline size_t PeakRssMiB() {
+            return PeakRssKiB() / 1024;
+        }
+
+        // Печатает время и пик резидентной памяти при заполнении вектора size элементами через PushBack
+        template <typename Vector>
+        void ReportHugeGrowth(const std::string& name, size_t size) {
+            using namespace std::string_literals;
+            ResetPeakRss();
+            const double ms = MeasureMs([size] {
+                Vector v;
+                for (size_t i = 0; i < size; ++i) {
+                    v.PushBack(static_cast<int>(i));
+                }
+                DoNotOptimize(v.begin());
+            });
+            std::cout << name << ": "s << ms << " ms, peak RSS="s << PeakRssMiB() << " MiB"s << std::endl;
+        }
+
+        // Возвращает среднее время одного вызова compare в наносекундах
+        template <typename Compare>
+        double MeasureCompareNs(size_t repeats, Compare compare) {
+            size_t hits = 0;
+            const double ms = MeasureMs([repeats, &compare, &hits] {
+                for (size_t i = 0; i < repeats; ++i) {
+                    hits += compare() ? 1 : 0;
+                }
+            });
+            DoNotOptimize(&hits);
+            return ms * 1e6 / static_cast<double>(repeats);
+        }
+
+        // Печатает время operator== и operator< для равных векторов (полный проход) в сравнении
+        // с поэлементными алгоритмами и memcmp
+        template <typename Type>
+        void ReportCompare(const std::string& name) {
+            using namespace std::string_literals;
+            for (const size_t size : { 16u, 256u, 4096u, 65536u, 1u << 20 }) {
+                SimpleVector<Type> a(size);
+                for (size_t i = 0; i < size; ++i) {
+                    a[i] = static_cast<Type>(i % 1000);
+                }
+                const SimpleVector<Type> b = a;
+                DoNotOptimize(b.begin());
+                const size_t repeats = std::max<size_t>(1, (1u << 26) / size);
+
+                const double equal = MeasureCompareNs(repeats, [&] {
+                    DoNotOptimize(a.begin());
+                    return a == b;
+                });
+                const double std_equal = MeasureCompareNs(repeats, [&] {
+                    DoNotOptimize(a.begin());
+                    return std::equal(a.begin(), a.end(), b.begin());
+                });
+                const double memcmp = MeasureCompareNs(repeats, [&] {
+                    DoNotOptimize(a.begin());
+                    return std::memcmp(a.begin(), b.begin(), size * sizeof(Type)) == 0;
+                });
+                const double less = MeasureCompareNs(repeats, [&] {
+                    DoNotOptimize(a.begin());
+                    return a < b;
+                });
+                const double std_less = MeasureCompareNs(repeats, [&] {
+                    DoNotOptimize(a.begin());
+                    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+                });
+                std::cout << name << ", size="s << size << ": =="s << equal << " ns (std::equal "s << std_equal
+                    << " ns, memcmp "s << memcmp << " ns), <"s << less << " ns (std::lexicographical_compare "s
+                    << std_less << " ns)"s << std::endl;
+            }
+        }
+
+        // Печатает процентили задержки отдельных вызовов PushBack при заполнении вектора size элементами
+        template <typename Vector>
+        void ReportAppendLatency(const std::string& name, size_t size) {
+            using namespace std::string_literals;
+            using Clock = std::chrono::steady_clock;
+            std::vector<double> latencies(size);
+            {
+                Vector v;
+                for (size_t i = 0; i < size; ++i) {
+                    const auto start = Clock::now();
+                    v.PushBack(Record{});
+                    const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+                    latencies[i] = elapsed.count();
+                }
+                DoNotOptimize(&v[0]);
+            }
+            std::sort(latencies.begin(), latencies.end());
+            const auto percentile = [&latencies](double p) {
+                return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))];
+            };
+            std::cout << name << ": p50="s << percentile(0.5) << " ns, p99="s << percentile(0.99) << " ns, p99.9="s
+                << percentile(0.999) << " ns, max="s << latencies.back() / 1e6 << " ms"s << std::endl;
+        }
+
+        template <typename SimpleScenario, typename StdScenario>
+        void Report(const std::string& name, SimpleScenario simple_scenario, StdScenario std_scenario) {
+            using namespace std::string_literals;
+            const size_t simple = CountConstructions(simple_scenario);
+            const size_t standard = CountConstructions(std_scenario);
+            std::cout << name << ": SimpleVector="s << simple << ", std::vector="s << standard << std::endl;
+        }
+
+        // Аллокатор std::vector, подсчитывающий выделения так же, как CountingAllocator
+        template <typename Type>
+        struct StdCountingAllocator {
+            using value_type = Type;
+
+            StdCountingAllocator() noexcept = default;
+
+            template <typename Other>
+            StdCountingAllocator(const StdCountingAllocator<Other>&) noexcept {
+            }
+
+            Type* allocate(size_t n) {
+                ++allocations;
+                return std::allocator<Type>().allocate(n);
+            }
+
+            void deallocate(Type* p, size_t n) noexcept {
+                std::allocator<Type>().deallocate(p, n);
+            }
+        };
+
+        template <typename Type, typename Other>
+        bool operator==(const StdCountingAllocator<Type>&, const StdCountingAllocator<Other>&) noexcept {
+            return true;
+        }
+
+        template <typename Type, typename Other>
+        bool operator!=(const StdCountingAllocator<Type>&, const StdCountingAllocator<Other>&) noexcept {
+            return false;
+        }
+
+        // Создает i-й элемент набора данных типа Type
+        template <typename Type>
+        Type MakeValue(size_t i) {
+            if constexpr (std::is_same_v<Type, std::string>) {
+                // Строки длиннее буфера короткой строки, чтобы копирование выделяло память
+                std::string value = std::to_string(i);
+                value.resize(32, '#');
+                return value;
+            }
+            else if constexpr (std::is_same_v<Type, Record>) {
+                Record record{};
+                std::memcpy(record.payload, &i, sizeof(i));
+                return record;
+            }
+            else {
+                return Type(static_cast<int>(i));
+            }
+        }
+
+        // Приводит вызовы SimpleVector и std::vector к общему виду для сценариев сравнения
+        template <typename Type>
+        struct SimpleVectorAdapter {
+            using Vector = SimpleVector<Type, CountingAllocator<Type>>;
+
+            static const char* Name() {
+                return "SimpleVector";
+            }
+
+            static void PushBack(Vector& v, Type&& value) {
+                v.PushBack(std::move(value));
+            }
+
+            static void Reserve(Vector& v, size_t n) {
+                v.Reserve(n);
+            }
+
+            static void Resize(Vector& v, size_t n) {
+                v.Resize(n);
+            }
+
+            static void Insert(Vector& v, size_t index, Type&& value) {
+                v.Insert(v.begin() + index, std::move(value));
+            }
+
+            static void Erase(Vector& v, size_t index) {
+                v.Erase(v.begin() + index);
+            }
+
+            static const void* Data(const Vector& v) {
+                return v.begin();
+            }
+        };
+
+        template <typename Type>
+        struct StdVectorAdapter {
+            using Vector = std::vector<Type, StdCountingAllocator<Type>>;
+
+            static const char* Name() {
+                return "std::vector";
+            }
+
+            static void PushBack(Vector& v, Type&& value) {
+                v.push_back(std::move(value));
+            }
+
+            static void Reserve(Vector& v, size_t n) {
+                v.reserve(n);
+            }
+
+            static void Resize(Vector& v, size_t n) {
+                v.resize(n);
+            }
+
+            static void Insert(Vector& v, size_t index, Type&& value) {
+                v.insert(v.begin() + index, std::move(value));
+            }
+
+            static void Erase(Vector& v, size_t index) {
+                v.erase(v.begin() + index);
+            }
+
+            static const void* Data(const Vector& v) {
+                return v.data();
+            }
+        };
+
+        // Записывает результаты сценариев в JSON-массив
+        class JsonReport {
+        public:
+            explicit JsonReport(std::ostream& out) : out_(out) {
+                out_ << "{\n  \"benchmarks\": [";
+            }
+
+            JsonReport(const JsonReport&) = delete;
+            JsonReport& operator=(const JsonReport&) = delete;
+
+            ~JsonReport() {
+                out_ << "\n  ]\n}" << std::endl;
+            }
+
+            void Add(const std::string& name, const std::string& type, const char* container, size_t size,
+                double ns_per_op, double allocations_per_run, size_t peak_rss_kib) {
+                out_ << (first_ ? "\n" : ",\n") << "    {\"name\": \"" << name << "\", \"type\": \"" << type
+                    << "\", \"container\": \"" << container << "\", \"size\": " << size << ", \"ns_per_op\": " << ns_per_op
+                    << ", \"allocations_per_run\": " << allocations_per_run << ", \"peak_rss_kib\": " << peak_rss_kib << "}";
+                first_ = false;
+            }
+
+        private:
+            std::ostream& out_;
+            bool first_ = true;
+        };
+
+        // Выполняет run() подготовленного сценария repeats раз и сообщает время на операцию
+        // (ops операций за прогон), число выделений памяти контейнером за прогон и пик резидентной памяти.
+        // prepare() вызывается перед каждым прогоном вне замера и возвращает его состояние
+        template <typename Prepare, typename Run>
+        void Measure(JsonReport& report, const std::string& name, const std::string& type, const char* container,
+            size_t size, size_t ops, size_t repeats, Prepare prepare, Run run) {
+            ResetPeakRss();
+            double total_ns = 0;
+            size_t total_allocations = 0;
+            for (size_t r = 0; r < repeats; ++r) {
+                auto state = prepare();
+                allocations = 0;
+                const auto start = std::chrono::steady_clock::now();
+                run(state);
+                const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+                total_ns += elapsed.count();
+                total_allocations += allocations;
+            }
+            report.Add(name, type, container, size, total_ns / static_cast<double>(repeats * std::max<size_t>(ops, 1)),
+                static_cast<double>(total_allocations) / static_cast<double>(repeats), PeakRssKiB());
+        }
+
+        // Заполняет вектор size элементами
+        template <typename Adapter, typename Type>
+        typename Adapter::Vector MakeVector(size_t size) {
+            typename Adapter::Vector v;
+            Adapter::Reserve(v, size);
+            for (size_t i = 0; i < size; ++i) {
+                Adapter::PushBack(v, MakeValue<Type>(i));
+            }
+            return v;
+        }
+
+        // Выполняет все сценарии набора для контейнера Adapter, элементов Type и размера size
+        template <typename Adapter, typename Type>
+        void RunSuiteScenarios(JsonReport& report, const std::string& type, size_t size) {
+            using Vector = typename Adapter::Vector;
+            const char* container = Adapter::Name();
+            const size_t repeats = std::max<size_t>(3, (1 << 20) / size);
+            const auto empty = [] {
+                return Vector();
+            };
+            const auto filled = [size] {
+                return MakeVector<Adapter, Type>(size);
+            };
+
+            // Элементы создаются до замера, чтобы время их создания не входило в результат
+            const auto values = [size] {
+                std::vector<Type> items;
+                items.reserve(size);
+                for (size_t i = 0; i < size; ++i) {
+                    items.push_back(MakeValue<Type>(i));
+                }
+                return std::make_pair(Vector(), std::move(items));
+            };
+            Measure(report, "push_back", type, container, size, size, repeats, values, [size](auto& state) {
+                for (size_t i = 0; i < size; ++i) {
+                    Adapter::PushBack(state.first, std::move(state.second[i]));
+                }
+                DoNotOptimize(Adapter::Data(state.first));
+            });
+            Measure(report, "push_back_reserved", type, container, size, size, repeats, values, [size](auto& state) {
+                Adapter::Reserve(state.first, size);
+                for (size_t i = 0; i < size; ++i) {
+                    Adapter::PushBack(state.first, std::move(state.second[i]));
+                }
+                DoNotOptimize(Adapter::Data(state.first));
+            });
+
+            // Вставка и удаление в середине сдвигают половину элементов
+            const size_t middle_ops = std::min<size_t>(size, 256);
+            const size_t middle_repeats = std::max<size_t>(3, (1 << 14) / size);
+            Measure(report, "insert_middle", type, container, size, middle_ops, middle_repeats, filled, [size, middle_ops](Vector& v) {
+                for (size_t i = 0; i < middle_ops; ++i) {
+                    Adapter::Insert(v, size / 2, MakeValue<Type>(i));
+                }
+                DoNotOptimize(Adapter::Data(v));
+            });
+            Measure(report, "erase_middle", type, container, size, middle_ops, middle_repeats, filled, [size, middle_ops](Vector& v) {
+                for (size_t i = 0; i < middle_ops; ++i) {
+                    Adapter::Erase(v, (size - i) / 2);
+                }
+                DoNotOptimize(Adapter::Data(v));
+            });
+
+            Measure(report, "resize", type, container, size, size, repeats, empty, [size](Vector& v) {
+                Adapter::Resize(v, size);
+                DoNotOptimize(Adapter::Data(v));
+            });
+
+            if constexpr (std::is_copy_constructible_v<Type>) {
+                Measure(report, "copy", type, container, size, size, repeats, filled, [](Vector& v) {
+                    Vector copy(v);
+                    DoNotOptimize(Adapter::Data(copy));
+                });
+            }
+            Measure(report, "move", type, container, size, 1, repeats, filled, [](Vector& v) {
+                Vector moved(std::move(v));
+                DoNotOptimize(Adapter::Data(moved));
+            });
+
+            if constexpr (std::is_same_v<Type, int> || std::is_same_v<Type, std::string>) {
+                const auto pair = [size] {
+                    return std::make_pair(MakeVector<Adapter, Type>(size), MakeVector<Adapter, Type>(size));
+                };
+                Measure(report, "equal", type, container, size, size, repeats, pair, [](auto& state) {
+                    bool result = state.first == state.second;
+                    DoNotOptimize(&result);
+                });
+                Measure(report, "less", type, container, size, size, repeats, pair, [](auto& state) {
+                    bool result = state.first < state.second;
+                    DoNotOptimize(&result);
+                });
+            }
+
+            Measure(report, "iterate", type, container, size, size, repeats, filled, [](Vector& v) {
+                size_t visited = 0;
+                for (const Type& item : v) {
+                    DoNotOptimize(&item);
+                    ++visited;
+                }
+                DoNotOptimize(&visited);
+            });
+        }
+
+        template <typename Type>
+        void RunSuiteType(JsonReport& report, const std::string& type) {
+            for (const size_t size : { 16u, 1024u, 65536u }) {
+                RunSuiteScenarios<SimpleVectorAdapter<Type>, Type>(report, type, size);
+                RunSuiteScenarios<StdVectorAdapter<Type>, Type>(report, type, size);
+            }
+        }
+
+    }
+
+}
+
+template <>
+struct IsTriviallyRelocatable<benchmarks::detail::Owner> : std::true_type {
+};
+
+namespace benchmarks {
+
+    void ConstructorCalls() {
+        using namespace std::string_literals;
+        using detail::Heavy;
+        std::cout << "Benchmark constructor calls"s << std::endl;
+        const size_t size = 1 << 16;
+
+        detail::Report("reserve + push back"s,
+            [size] {
+                SimpleVector<Heavy> v;
+                v.Reserve(size);
+                for (size_t i = 0; i < size; ++i) {
+                    v.PushBack(Heavy());
+                }
+            },
+            [size] {
+                std::vector<Heavy> v;
+                v.reserve(size);
+                for (size_t i = 0; i < size; ++i) {
+                    v.push_back(Heavy());
+                }
+            });
+
+        detail::Report("push back with growth"s,
+            [size] {
+                SimpleVector<Heavy> v;
+                for (size_t i = 0; i < size; ++i) {
+                    v.PushBack(Heavy());
+                }
+            },
+            [size] {
+                std::vector<Heavy> v;
+                for (size_t i = 0; i < size; ++i) {
+                    v.push_back(Heavy());
+                }
+            });
+
+        detail::Report("resize by doubling"s,
+            [size] {
+                SimpleVector<Heavy> v;
+                for (size_t i = 1; i <= size; i *= 2) {
+                    v.Resize(i);
+                }
+            },
+            [size] {
+                std::vector<Heavy> v;
+                for (size_t i = 1; i <= size; i *= 2) {
+                    v.resize(i);
+                }
+            });
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void Relocation() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark relocation on growth"s << std::endl;
+        detail::ReportPushBack<int>("push back int"s, 10'000'000);
+        detail::ReportPushBack<detail::Record>("push back 64-byte record"s, 2'000'000);
+        detail::ReportPushBack<detail::Owner>("push back relocatable owner"s, 2'000'000);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void SmallVectorAllocations() {
+        using namespace std::string_literals;
+        using detail::CountingAllocator;
+        std::cout << "Benchmark small vector allocations"s << std::endl;
+        const size_t count = 1'000'000;
+
+        detail::allocations = 0;
+        const double simple = detail::MeasureMs([count] {
+            detail::FillShortVectors<SimpleVector<int, CountingAllocator<int>>>(count);
+        });
+        const size_t simple_allocations = detail::allocations;
+
+        detail::allocations = 0;
+        const double small = detail::MeasureMs([count] {
+            detail::FillShortVectors<SmallSimpleVector<int, 8, CountingAllocator<int>>>(count);
+        });
+        const size_t small_allocations = detail::allocations;
+
+        std::cout << "vectors of 0..8 ints: count="s << count
+            << ", SimpleVector="s << simple << " ms, "s << simple_allocations << " allocations"s
+            << ", SmallSimpleVector<8>="s << small << " ms, "s << small_allocations << " allocations"s << std::endl;
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void BulkInsert() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark bulk insert"s << std::endl;
+        const size_t size = 10'000'000;
+        std::vector<int> source(size);
+        for (size_t i = 0; i < size; ++i) {
+            source[i] = static_cast<int>(i);
+        }
+
+        const double push_back = detail::MeasureMs([&source] {
+            SimpleVector<int> v;
+            for (int x : source) {
+                v.PushBack(x);
+            }
+            detail::DoNotOptimize(v.begin());
+        });
+        const double append = detail::MeasureMs([&source] {
+            SimpleVector<int> v;
+            v.Append(source);
+            detail::DoNotOptimize(v.begin());
+        });
+        std::cout << "load 10M ints: PushBack loop="s << push_back << " ms, Append="s << append << " ms"s << std::endl;
+
+        const size_t chunk = 1000;
+        const double insert_loop = detail::MeasureMs([&source, chunk] {
+            SimpleVector<int> v(source.begin(), source.begin() + 1'000'000);
+            for (size_t i = 0; i < chunk; ++i) {
+                v.Insert(v.begin() + 500'000 + i, source[i]);
+            }
+            detail::DoNotOptimize(v.begin());
+        });
+        const double insert_range = detail::MeasureMs([&source, chunk] {
+            SimpleVector<int> v(source.begin(), source.begin() + 1'000'000);
+            v.Insert(v.begin() + 500'000, source.begin(), source.begin() + chunk);
+            detail::DoNotOptimize(v.begin());
+        });
+        std::cout << "insert 1000 ints into middle of 1M: Insert loop="s << insert_loop << " ms, range Insert="s << insert_range << " ms"s << std::endl;
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void EraseIf() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark erase if"s << std::endl;
+        // Удаляется примерно 30% элементов
+        const auto is_garbage = [](int x) {
+            return x % 10 < 3;
+        };
+
+        for (const size_t size : { 100'000u, 10'000'000u }) {
+            std::vector<int> source(size);
+            for (size_t i = 0; i < size; ++i) {
+                source[i] = static_cast<int>(i * 7919 % 1000);
+            }
+
+            if (size <= 100'000) {
+                const double erase_loop = detail::MeasureMs([&source, &is_garbage] {
+                    SimpleVector<int> v(source.begin(), source.end());
+                    for (auto it = v.begin(); it != v.end();) {
+                        it = is_garbage(*it) ? v.Erase(it) : it + 1;
+                    }
+                    detail::DoNotOptimize(v.begin());
+                });
+                std::cout << "size="s << size << ": Erase loop="s << erase_loop << " ms"s << std::endl;
+            }
+
+            const double erase_if = detail::MeasureMs([&source, &is_garbage] {
+                SimpleVector<int> v(source.begin(), source.end());
+                ::EraseIf(v, is_garbage);
+                detail::DoNotOptimize(v.begin());
+            });
+            std::cout << "size="s << size << ": EraseIf="s << erase_if << " ms"s << std::endl;
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void GrowthFootprint() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark growth policy memory footprint"s << std::endl;
+        const size_t count = 10'000;
+        detail::ReportFootprint<DoublingGrowth>("2x"s, count);
+        detail::ReportFootprint<OneAndHalfGrowth>("1.5x"s, count);
+        detail::ReportFootprint<SizeClassGrowth<>>("2x rounded to size classes"s, count);
+        detail::ReportFootprint<SizeClassGrowth<OneAndHalfGrowth>>("1.5x rounded to size classes"s, count);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void MmapGrowth() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark mmap growth"s << std::endl;
+        const size_t size = 256'000'000;
+        std::cout << "push back "s << size << " ints ("s << size * sizeof(int) / (1 << 20) << " MiB)"s << std::endl;
+        detail::ReportHugeGrowth<SimpleVector<int, MmapAllocator<int>>>("MmapAllocator"s, size);
+        detail::ReportHugeGrowth<SimpleVector<int, MmapAllocator<int, kDefaultMmapThreshold, true>>>("MmapAllocator + MADV_HUGEPAGE"s, size);
+        detail::ReportHugeGrowth<SimpleVector<int>>("MallocAllocator"s, size);
+        detail::ReportHugeGrowth<SimpleVector<int, std::allocator<int>>>("std::allocator (allocate + copy)"s, size);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void Compare() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark compare"s << std::endl;
+        const char* const levels[] = { "scalar", "SSE2", "AVX2" };
+        std::cout << "kernels: "s << levels[static_cast<int>(::detail::DetectSimdLevel())] << std::endl;
+        detail::ReportCompare<int>("int"s);
+        detail::ReportCompare<float>("float"s);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void ParallelScaling() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark parallel construction scaling"s << std::endl;
+        const size_t size = 64'000'000;
+        std::cout << "vectors of "s << size << " int64 ("s << size * sizeof(int64_t) / (1 << 20) << " MiB), hardware threads: "s
+            << std::thread::hardware_concurrency() << std::endl;
+        const SimpleVector<int64_t> source(size, 1);
+        for (const size_t threads : { 1u, 2u, 4u, 8u, 16u }) {
+            const ParallelExecution execution{ threads };
+            const double fill = detail::MeasureMs([&execution, size] {
+                SimpleVector<int64_t> v(size, 42, execution);
+                detail::DoNotOptimize(v.begin());
+            });
+            const double copy = detail::MeasureMs([&execution, &source] {
+                SimpleVector<int64_t> v(source, execution);
+                detail::DoNotOptimize(v.begin());
+            });
+            const double resize = detail::MeasureMs([&execution, size] {
+                SimpleVector<int64_t> v;
+                v.Resize(size, execution);
+                detail::DoNotOptimize(v.begin());
+            });
+            std::cout << "threads="s << threads << ": fill constructor="s << fill << " ms, copy="s << copy
+                << " ms, Resize="s << resize << " ms"s << std::endl;
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void ConcurrentAppend() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark concurrent append"s << std::endl;
+        const size_t total = 8'000'000;
+        for (const size_t threads : { 1u, 2u, 4u, 8u }) {
+            const size_t per_thread = total / threads;
+
+            const double locked = detail::MeasureMs([threads, per_thread] {
+                SimpleVector<int> v;
+                std::mutex mutex;
+                std::vector<std::thread> workers;
+                for (size_t t = 0; t < threads; ++t) {
+                    workers.emplace_back([&v, &mutex, per_thread] {
+                        for (size_t i = 0; i < per_thread; ++i) {
+                            std::lock_guard guard(mutex);
+                            v.PushBack(static_cast<int>(i));
+                        }
+                    });
+                }
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+                detail::DoNotOptimize(v.begin());
+            });
+
+            const double concurrent = detail::MeasureMs([threads, per_thread] {
+                ConcurrentSimpleVector<int> v;
+                std::vector<std::thread> workers;
+                for (size_t t = 0; t < threads; ++t) {
+                    workers.emplace_back([&v, per_thread] {
+                        for (size_t i = 0; i < per_thread; ++i) {
+                            v.PushBack(static_cast<int>(i));
+                        }
+                    });
+                }
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+                detail::DoNotOptimize(&v);
+            });
+
+            std::cout << "threads="s << threads << ", "s << total << " ints: mutex + SimpleVector="s << locked
+                << " ms, ConcurrentSimpleVector="s << concurrent << " ms"s << std::endl;
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void AppendLatency() {
+        using namespace std::string_literals;
+        using detail::Record;
+        std::cout << "Benchmark append latency"s << std::endl;
+        const size_t size = 2'000'000;
+        std::cout << "push back "s << size << " 64-byte records"s << std::endl;
+        detail::ReportAppendLatency<SimpleVector<Record>>("SimpleVector (realloc)"s, size);
+        detail::ReportAppendLatency<SimpleVector<Record, std::allocator<Record>>>("SimpleVector (allocate + copy)"s, size);
+        detail::ReportAppendLatency<SegmentedVector<Record>>("SegmentedVector"s, size);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void MappedLoad() {
+        using namespace std::string_literals;
+        using detail::Record;
+        std::cout << "Benchmark mapped file load"s << std::endl;
+        const size_t size = 4'000'000;
+        const std::string path = (std::filesystem::temp_directory_path() / "simple_vector_mapped_benchmark.bin").string();
+        {
+            SimpleVector<Record> table(size);
+            for (size_t i = 0; i < size; ++i) {
+                std::memcpy(table[i].payload, &i, sizeof(i));
+            }
+            SaveToFile(table, path);
+        }
+        std::cout << "load "s << size << " 64-byte records ("s << size * sizeof(Record) / (1 << 20) << " MiB)"s << std::endl;
+
+        const double read = detail::MeasureMs([&path, size] {
+            std::ifstream in(path, std::ios::binary);
+            in.seekg(kMappedDataOffset);
+            SimpleVector<Record> table(size);
+            in.read(reinterpret_cast<char*>(table.begin()), size * sizeof(Record));
+            detail::DoNotOptimize(table.begin());
+        });
+        const double map = detail::MeasureMs([&path] {
+            const MappedSimpleVector<Record> table(path);
+            detail::DoNotOptimize(table.begin());
+        });
+        const double map_lookup = detail::MeasureMs([&path, size] {
+            const MappedSimpleVector<Record> table(path);
+            size_t sum = 0;
+            for (size_t i = 0; i < 1000; ++i) {
+                size_t key;
+                std::memcpy(&key, table[i * (size / 1000)].payload, sizeof(key));
+                sum += key;
+            }
+            detail::DoNotOptimize(&sum);
+        });
+        std::cout << "read into SimpleVector: "s << read << " ms, map: "s << map << " ms, map + 1000 random lookups: "s
+            << map_lookup << " ms"s << std::endl;
+        std::filesystem::remove(path);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void Serialization() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark serialization"s << std::endl;
+        const size_t size = 32'000'000;
+        const double gigabytes = static_cast<double>(size * sizeof(int64_t)) / 1e9;
+        const std::string path = (std::filesystem::temp_directory_path() / "simple_vector_serialization_benchmark.bin").string();
+        SimpleVector<int64_t> source(size);
+        for (size_t i = 0; i < size; ++i) {
+            source[i] = static_cast<int64_t>(i);
+        }
+        std::cout << size << " int64 ("s << size * sizeof(int64_t) / (1 << 20) << " MiB) through a file"s << std::endl;
+
+        const double naive_write = detail::MeasureMs([&path, &source] {
+            std::ofstream out(path, std::ios::binary);
+            const uint64_t count = source.GetSize();
+            out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            for (const int64_t item : source) {
+                out.write(reinterpret_cast<const char*>(&item), sizeof(item));
+            }
+        });
+        const double naive_read = detail::MeasureMs([&path] {
+            std::ifstream in(path, std::ios::binary);
+            uint64_t count = 0;
+            in.read(reinterpret_cast<char*>(&count), sizeof(count));
+            SimpleVector<int64_t> v;
+            for (uint64_t i = 0; i < count; ++i) {
+                int64_t item;
+                in.read(reinterpret_cast<char*>(&item), sizeof(item));
+                v.PushBack(item);
+            }
+            detail::DoNotOptimize(v.begin());
+        });
+        std::cout << "per-element ostream loop: write "s << gigabytes / naive_write * 1000 << " GB/s, read "s
+            << gigabytes / naive_read * 1000 << " GB/s"s << std::endl;
+
+        for (const bool checksum : { false, true }) {
+            const double write = detail::MeasureMs([&path, &source, checksum] {
+                std::ofstream out(path, std::ios::binary);
+                Serialize(out, source, { checksum });
+            });
+            const double read = detail::MeasureMs([&path] {
+                std::ifstream in(path, std::ios::binary);
+                SimpleVector<int64_t> v;
+                Deserialize(in, v);
+                detail::DoNotOptimize(v.begin());
+            });
+            std::cout << "Serialize/Deserialize"s << (checksum ? " with checksum"s : ""s) << ": write "s
+                << gigabytes / write * 1000 << " GB/s, read "s << gigabytes / read * 1000 << " GB/s"s << std::endl;
+        }
+        std::filesystem::remove(path);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void StructureOfArrays() {
+        using namespace std::string_literals;
+        using detail::Trade;
+        std::cout << "Benchmark structure of arrays"s << std::endl;
+        const size_t size = 4'000'000;
+        const int passes = 10;
+        SimpleVector<Trade> rows;
+        rows.Reserve(size);
+        SoaVector<double, int64_t, int64_t, int64_t, int64_t, int64_t, int64_t, int64_t> columns;
+        columns.Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            const auto value = static_cast<int64_t>(i);
+            rows.PushBack({ i * 0.25, value, { value, value, value, value, value, value } });
+            columns.PushBack(i * 0.25, value, value, value, value, value, value, value);
+        }
+        std::cout << size << " 64-byte records, "s << passes << " passes summing one field"s << std::endl;
+
+        double aos_sum = 0;
+        const double aos = detail::MeasureMs([&rows, &aos_sum, passes] {
+            for (int pass = 0; pass < passes; ++pass) {
+                for (const Trade& trade : rows) {
+                    aos_sum += trade.price;
+                }
+            }
+        });
+        double soa_sum = 0;
+        const double soa = detail::MeasureMs([&columns, &soa_sum, passes] {
+            const SimpleVectorView<const double> prices = std::as_const(columns).GetColumn<0>();
+            for (int pass = 0; pass < passes; ++pass) {
+                for (const double price : prices) {
+                    soa_sum += price;
+                }
+            }
+        });
+        int64_t aos_quantity = 0;
+        const double aos_int = detail::MeasureMs([&rows, &aos_quantity, passes] {
+            for (int pass = 0; pass < passes; ++pass) {
+                for (const Trade& trade : rows) {
+                    aos_quantity += trade.quantity;
+                }
+            }
+        });
+        int64_t soa_quantity = 0;
+        const double soa_int = detail::MeasureMs([&columns, &soa_quantity, passes] {
+            const SimpleVectorView<const int64_t> quantities = std::as_const(columns).GetColumn<1>();
+            for (int pass = 0; pass < passes; ++pass) {
+                for (const int64_t quantity : quantities) {
+                    soa_quantity += quantity;
+                }
+            }
+        });
+        detail::DoNotOptimize(&aos_sum);
+        detail::DoNotOptimize(&soa_sum);
+        detail::DoNotOptimize(&aos_quantity);
+        detail::DoNotOptimize(&soa_quantity);
+        std::cout << "sum of double field: SimpleVector<Trade>="s << aos << " ms, SoaVector column="s << soa << " ms"s << std::endl;
+        std::cout << "sum of int64 field: SimpleVector<Trade>="s << aos_int << " ms, SoaVector column="s << soa_int << " ms"s << std::endl;
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void AlignedKernels() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark aligned storage"s << std::endl;
+#if SIMPLE_VECTOR_X86_SIMD
+        if (::detail::DetectSimdLevel() != ::detail::SimdLevel::kAvx2) {
+            std::cout << "AVX2 is not available, skipped"s << std::endl << std::endl;
+            return;
+        }
+        const size_t size = 1001;
+        const size_t repeats = 200'000;
+
+        // Невыровненный случай: векторы, сдвинутые на один элемент от начала блока malloc
+        SimpleVector<float> x(size + 1, 1.0f);
+        SimpleVector<float> y(size + 1, 0.0f);
+        const double unaligned = detail::MeasureMs([&x, &y, size, repeats] {
+            for (size_t r = 0; r < repeats; ++r) {
+                detail::SaxpyUnaligned(0.5f, x.begin() + 1, y.begin() + 1, size);
+                detail::DoNotOptimize(y.begin());
+            }
+        });
+
+        AlignedSimpleVector<float, 32> aligned_x;
+        AlignedSimpleVector<float, 32> aligned_y;
+        for (size_t i = 0; i < size; ++i) {
+            aligned_x.PushBack(1.0f);
+            aligned_y.PushBack(0.0f);
+        }
+        const size_t blocks = (size + 7) / 8;
+        const double aligned = detail::MeasureMs([&aligned_x, &aligned_y, blocks, repeats] {
+            for (size_t r = 0; r < repeats; ++r) {
+                detail::SaxpyAligned(0.5f, aligned_x.AlignedData(), aligned_y.AlignedData(), blocks);
+                detail::DoNotOptimize(aligned_y.begin());
+            }
+        });
+        std::cout << "saxpy over "s << size << " floats x "s << repeats << ": unaligned loads + scalar tail="s << unaligned
+            << " ms, AlignedSimpleVector<float, 32> aligned loads over padded capacity="s << aligned << " ms"s << std::endl;
+#else
+        std::cout << "AVX is not available, skipped"s << std::endl;
+#endif
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void Instrumentation() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark instrumentation overhead"s << std::endl;
+        // Сравнивается сборка с -DSIMPLE_VECTOR_INSTRUMENTATION и без него
+        std::cout << "instrumentation: "s << (kVectorInstrumentation ? "on"s : "off"s) << std::endl;
+        const size_t vectors = 200'000;
+        const double push_back = detail::MeasureMs([vectors] {
+            for (size_t i = 0; i < vectors; ++i) {
+                SimpleVector<int> v;
+                for (int j = 0; j < 64; ++j) {
+                    v.PushBack(j);
+                }
+                detail::DoNotOptimize(v.begin());
+            }
+        });
+        const double insert_erase = detail::MeasureMs([vectors] {
+            SimpleVector<int> v(256);
+            for (size_t i = 0; i < vectors * 10; ++i) {
+                v.Insert(v.begin() + i % 128, static_cast<int>(i));
+                v.Erase(v.begin() + i % 200);
+            }
+            detail::DoNotOptimize(v.begin());
+        });
+        std::cout << vectors << " vectors x 64 push backs="s << push_back << " ms, "s << vectors * 10
+            << " insert + erase pairs="s << insert_erase << " ms"s << std::endl;
+        if constexpr (kVectorInstrumentation) {
+            const VectorStats stats = GetVectorStats<int>();
+            std::cout << "int vectors: allocations="s << stats.allocations << ", relocated elements="s << stats.relocated_elements
+                << ", insert shifts="s << stats.insert_shifted_elements << ", erase shifts="s << stats.erase_shifted_elements << std::endl;
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void OverwriteGrowth() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark buffer growth for overwrite"s << std::endl;
+        const size_t chunk = 1 << 16;
+        const size_t total = 64 << 20;
+        SimpleVector<char> source(chunk, 'x');
+        // Имитирует read: копирует до count байт из source
+        const auto read = [&source](char* destination, size_t count) {
+            const size_t bytes = std::min(count, source.GetSize());
+            std::memcpy(destination, source.begin(), bytes);
+            return bytes;
+        };
+
+        const int passes = 20;
+        const double resize = detail::MeasureMs([&read, passes] {
+            SimpleVector<char> buffer;
+            for (int pass = 0; pass < passes; ++pass) {
+                buffer.Clear();
+                for (size_t done = 0; done < total;) {
+                    buffer.Resize(done + chunk);
+                    done += read(buffer.begin() + done, chunk);
+                }
+                detail::DoNotOptimize(buffer.begin());
+            }
+        });
+        const double overwrite = detail::MeasureMs([&read, passes] {
+            SimpleVector<char> buffer;
+            for (int pass = 0; pass < passes; ++pass) {
+                buffer.Clear();
+                for (size_t done = 0; done < total;) {
+                    buffer.ResizeForOverwrite(done + chunk);
+                    done += read(buffer.begin() + done, chunk);
+                }
+                detail::DoNotOptimize(buffer.begin());
+            }
+        });
+        const double append = detail::MeasureMs([&read, passes] {
+            SimpleVector<char> buffer;
+            for (int pass = 0; pass < passes; ++pass) {
+                buffer.Clear();
+                while (buffer.GetSize() < total) {
+                    buffer.ReserveAndAppend(chunk, read);
+                }
+                detail::DoNotOptimize(buffer.begin());
+            }
+        });
+        std::cout << passes << " x "s << (total >> 20) << " MiB read in "s << (chunk >> 10) << " KiB chunks: Resize="s << resize
+            << " ms, ResizeForOverwrite="s << overwrite << " ms, ReserveAndAppend="s << append << " ms"s << std::endl;
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void SortedContainers() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark sorted containers"s << std::endl;
+        const size_t size = 1 << 20;
+        const size_t lookups = 4'000'000;
+        std::mt19937 generator(1);
+        std::vector<std::pair<int, int>> items(size);
+        for (size_t i = 0; i < size; ++i) {
+            items[i] = { static_cast<int>(generator() >> 1), static_cast<int>(i) };
+        }
+        std::vector<int> keys(lookups);
+        for (size_t i = 0; i < lookups; ++i) {
+            // Половина ключей есть в таблице
+            keys[i] = i % 2 == 0 ? items[generator() % size].first : static_cast<int>(generator() >> 1);
+        }
+
+        FlatMap<int, int> flat;
+        std::map<int, int> tree;
+        const double flat_build = detail::MeasureMs([&flat, &items] {
+            flat.Insert(items.begin(), items.end());
+        });
+        const double tree_build = detail::MeasureMs([&tree, &items] {
+            tree.insert(items.begin(), items.end());
+        });
+        const auto lookup = [&keys](const auto& table) {
+            int64_t sum = 0;
+            return detail::MeasureMs([&keys, &table, &sum] {
+                for (const int key : keys) {
+                    sum += table.count(key);
+                }
+                detail::DoNotOptimize(&sum);
+            });
+        };
+        struct FlatCount {
+            const FlatMap<int, int>& map;
+            size_t count(int key) const {
+                return map.Contains(key) ? 1 : 0;
+            }
+        };
+        const double flat_lookup = lookup(FlatCount{ flat });
+        const double tree_lookup = lookup(tree);
+        std::cout << size << " entries: build FlatMap="s << flat_build << " ms, std::map="s << tree_build << " ms; "s
+            << lookups << " lookups FlatMap="s << flat_lookup << " ms, std::map="s << tree_lookup << " ms"s << std::endl;
+
+        // Каждая вставка чередуется с несколькими поисками
+        const size_t inserts = 200'000;
+        const size_t lookups_per_insert = 8;
+        const auto mixed = [&items, &keys, inserts, lookups_per_insert](auto& table, auto insert, auto contains) {
+            int64_t sum = 0;
+            return detail::MeasureMs([&] {
+                for (size_t i = 0; i < inserts; ++i) {
+                    insert(table, items[i]);
+                    for (size_t j = 0; j < lookups_per_insert; ++j) {
+                        sum += contains(table, keys[(i * lookups_per_insert + j) % keys.size()]);
+                    }
+                }
+                detail::DoNotOptimize(&sum);
+            });
+        };
+        FlatMap<int, int> flat_mixed;
+        std::map<int, int> tree_mixed;
+        const double flat_time = mixed(flat_mixed, [](auto& table, const std::pair<int, int>& item) {
+            table.Insert(item.first, item.second);
+        }, [](const auto& table, int key) {
+            return table.Contains(key);
+        });
+        const double tree_time = mixed(tree_mixed, [](auto& table, const std::pair<int, int>& item) {
+            table.insert(item);
+        }, [](const auto& table, int key) {
+            return table.count(key) == 1;
+        });
+        std::cout << inserts << " inserts with "s << lookups_per_insert << " lookups each: FlatMap="s << flat_time
+            << " ms, std::map="s << tree_time << " ms"s << std::endl;
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void BitVectorOps() {
+        using namespace std::string_literals;
+        std::cout << "Benchmark bit vector"s << std::endl;
+        const size_t bits = 1 << 28;
+        std::mt19937_64 generator(5);
+        BitVector a(bits);
+        BitVector b(bits);
+        SimpleVector<bool> bytes_a(bits);
+        SimpleVector<bool> bytes_b(bits);
+        for (size_t i = 0; i < bits; ++i) {
+            const uint64_t random = generator();
+            a[i] = bytes_a[i] = (random & 1) != 0;
+            b[i] = bytes_b[i] = (random & 2) != 0;
+        }
+        const double megabytes = static_cast<double>(a.GetWords().GetSize() * sizeof(uint64_t)) / (1 << 20);
+        std::cout << bits << " flags: BitVector="s << megabytes << " MiB, SimpleVector<bool>="s << bits / (1 << 20) << " MiB"s << std::endl;
+
+        const int passes = 10;
+        const double bit_and = detail::MeasureMs([&a, &b, passes] {
+            for (int pass = 0; pass < passes; ++pass) {
+                a &= b;
+                a |= b;
+            }
+            detail::DoNotOptimize(a.GetWords().Data());
+        }) / (2 * passes);
+        const double bool_and = detail::MeasureMs([&bytes_a, &bytes_b, passes] {
+            for (int pass = 0; pass < passes; ++pass) {
+                for (size_t i = 0; i < bytes_a.GetSize(); ++i) {
+                    bytes_a[i] = bytes_a[i] && bytes_b[i];
+                }
+                for (size_t i = 0; i < bytes_a.GetSize(); ++i) {
+                    bytes_a[i] = bytes_a[i] || bytes_b[i];
+                }
+            }
+            detail::DoNotOptimize(bytes_a.begin());
+        }) / (2 * passes);
+        // Пропускная способность: чтение двух векторов и запись одного
+        std::cout << "AND/OR: BitVector="s << bit_and << " ms ("s << 3 * megabytes / 1024 / bit_and * 1000 << " GB/s), SimpleVector<bool>="s
+            << bool_and << " ms"s << std::endl;
+
+        size_t count = 0;
+        const double bit_count = detail::MeasureMs([&a, &count, passes] {
+            for (int pass = 0; pass < passes; ++pass) {
+                count += a.Count();
+            }
+        }) / passes;
+        const double bool_count = detail::MeasureMs([&bytes_a, &count, passes] {
+            for (int pass = 0; pass < passes; ++pass) {
+                count += std::count(bytes_a.begin(), bytes_a.end(), true);
+            }
+        }) / passes;
+        detail::DoNotOptimize(&count);
+        std::cout << "Count: BitVector="s << bit_count << " ms ("s << megabytes / 1024 / bit_count * 1000 << " GB/s), SimpleVector<bool>="s
+            << bool_count << " ms"s << std::endl;
+
+        const double bit_push = detail::MeasureMs([bits] {
+            BitVector v;
+            for (size_t i = 0; i < bits; ++i) {
+                v.PushBack((i & 5) == 1);
+            }
+            detail::DoNotOptimize(v.GetWords().Data());
+        });
+        const double bool_push = detail::MeasureMs([bits] {
+            SimpleVector<bool> v;
+            for (size_t i = 0; i < bits; ++i) {
+                v.PushBack((i & 5) == 1);
+            }
+            detail::DoNotOptimize(v.begin());
+        });
+        const double bit_append = detail::MeasureMs([bits] {
+            BitVector v;
+            for (size_t i = 0; i < bits; i += 64) {
+                v.AppendBits(0x2222222222222222);
+            }
+            detail::DoNotOptimize(v.GetWords().Data());
+        });
+        std::cout << "PushBack: BitVector="s << bit_push << " ms, SimpleVector<bool>="s << bool_push
+            << " ms; BitVector::AppendBits by words="s << bit_append << " ms"s << std::endl;
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void Suite(std::ostream& out) {
+        detail::JsonReport report(out);
+        detail::RunSuiteType<int>(report, "int");
+        detail::RunSuiteType<detail::Record>(report, "pod64");
+        detail::RunSuiteType<std::string>(report, "std::string");
+        detail::RunSuiteType<tests::detail::X>(report, "tests::detail::X");
+    }
+
+}
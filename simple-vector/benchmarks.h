@@ -0,0 +1,49 @@
+#pragma once
+
+#include <ostream>
+
+namespace benchmarks {
+
+    void ConstructorCalls();
+
+    void Relocation();
+
+    void SmallVectorAllocations();
+
+    void BulkInsert();
+
+    void EraseIf();
+
+    void GrowthFootprint();
+
+    void MmapGrowth();
+
+    void Compare();
+
+    void ParallelScaling();
+
+    void ConcurrentAppend();
+
+    void AppendLatency();
+
+    void MappedLoad();
+
+    void Serialization();
+
+    void StructureOfArrays();
+
+    void AlignedKernels();
+
+    void Instrumentation();
+
+    void OverwriteGrowth();
+
+    void SortedContainers();
+
+    void BitVectorOps();
+
+    // Сравнивает SimpleVector с std::vector на типовых операциях для int, 64-байтовой записи,
+    // std::string и перемещаемого tests::detail::X и пишет результаты в out в формате JSON
+    void Suite(std::ostream& out);
+
+}
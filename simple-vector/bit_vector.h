@@ -0,0 +1,714 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "compare_kernels.h"
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+namespace detail {
+
+    using BitWord = uint64_t;
+
+    inline constexpr size_t kBitsPerWord = std::numeric_limits<BitWord>::digits;
+
+    // Возвращает число единичных битов слова
+    inline size_t PopCount(BitWord word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        word = word - ((word >> 1) & 0x5555555555555555);
+        word = (word & 0x3333333333333333) + ((word >> 2) & 0x3333333333333333);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0F;
+        return static_cast<size_t>((word * 0x0101010101010101) >> 56);
+#endif
+    }
+
+    // Возвращает индекс младшего единичного бита ненулевого слова
+    inline size_t CountTrailingZeros(BitWord word) noexcept {
+        assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(word));
+#else
+        size_t count = 0;
+        for (; (word & 1) == 0; word >>= 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // Побитовые операции над массивами слов
+    enum class BitOp {
+        kAnd,
+        kOr,
+        kXor,
+    };
+
+    template <BitOp Op>
+    inline BitWord ApplyBitOp(BitWord lhs, BitWord rhs) noexcept {
+        if constexpr (Op == BitOp::kAnd) {
+            return lhs & rhs;
+        }
+        else if constexpr (Op == BitOp::kOr) {
+            return lhs | rhs;
+        }
+        else {
+            return lhs ^ rhs;
+        }
+    }
+
+    // Выполняет dst[i] = dst[i] Op src[i] для n слов
+    template <BitOp Op>
+    void BitwiseWordsScalar(BitWord* dst, const BitWord* src, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = ApplyBitOp<Op>(dst[i], src[i]);
+        }
+    }
+
+    inline size_t PopCountWordsScalar(const BitWord* words, size_t n) noexcept {
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            count += PopCount(words[i]);
+        }
+        return count;
+    }
+
+#if SIMPLE_VECTOR_X86_SIMD
+
+    template <BitOp Op>
+    __attribute__((target("avx2")))
+    inline __m256i ApplyBitOpAvx2(__m256i lhs, __m256i rhs) noexcept {
+        if constexpr (Op == BitOp::kAnd) {
+            return _mm256_and_si256(lhs, rhs);
+        }
+        else if constexpr (Op == BitOp::kOr) {
+            return _mm256_or_si256(lhs, rhs);
+        }
+        else {
+            return _mm256_xor_si256(lhs, rhs);
+        }
+    }
+
+    // Обрабатывает по 8 слов (два регистра AVX2) за итерацию
+    template <BitOp Op>
+    __attribute__((target("avx2")))
+    void BitwiseWordsAvx2(BitWord* dst, const BitWord* src, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i* const out = reinterpret_cast<__m256i*>(dst + i);
+            const __m256i* const in = reinterpret_cast<const __m256i*>(src + i);
+            const __m256i x0 = ApplyBitOpAvx2<Op>(_mm256_loadu_si256(out), _mm256_loadu_si256(in));
+            const __m256i x1 = ApplyBitOpAvx2<Op>(_mm256_loadu_si256(out + 1), _mm256_loadu_si256(in + 1));
+            _mm256_storeu_si256(out, x0);
+            _mm256_storeu_si256(out + 1, x1);
+        }
+        BitwiseWordsScalar<Op>(dst + i, src + i, n - i);
+    }
+
+    // Базовый набор x86-64 не содержит popcnt, поэтому __builtin_popcountll без него раскрывается
+    // в последовательность сдвигов и масок
+    __attribute__((target("popcnt")))
+    inline size_t PopCountWordsPopcnt(const BitWord* words, size_t n) noexcept {
+        // Четыре независимых счетчика не ждут друг друга
+        size_t c0 = 0;
+        size_t c1 = 0;
+        size_t c2 = 0;
+        size_t c3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            c0 += static_cast<size_t>(__builtin_popcountll(words[i]));
+            c1 += static_cast<size_t>(__builtin_popcountll(words[i + 1]));
+            c2 += static_cast<size_t>(__builtin_popcountll(words[i + 2]));
+            c3 += static_cast<size_t>(__builtin_popcountll(words[i + 3]));
+        }
+        for (; i < n; ++i) {
+            c0 += static_cast<size_t>(__builtin_popcountll(words[i]));
+        }
+        return c0 + c1 + c2 + c3;
+    }
+
+    // Считает биты по 4 слова за итерацию: число битов в каждой тетраде берется из таблицы
+    // инструкцией vpshufb, а суммы байтов накапливаются в 64-битных полях через vpsadbw
+    __attribute__((target("avx2")))
+    inline size_t PopCountWordsAvx2(const BitWord* words, size_t n) noexcept {
+        const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_mask = _mm256_set1_epi8(0x0F);
+        __m256i total = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+            const __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low_mask));
+            const __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask));
+            total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+        }
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+        return static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + PopCountWordsScalar(words + i, n - i);
+    }
+
+    inline bool HasPopcnt() noexcept {
+        static const bool supported = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("popcnt") != 0;
+        }();
+        return supported;
+    }
+
+#endif
+
+    // Выполняет dst[i] = dst[i] Op src[i] для n слов блоками AVX2, если процессор их поддерживает
+    template <BitOp Op>
+    void BitwiseWords(BitWord* dst, const BitWord* src, size_t n) noexcept {
+#if SIMPLE_VECTOR_X86_SIMD
+        if (DetectSimdLevel() == SimdLevel::kAvx2) {
+            BitwiseWordsAvx2<Op>(dst, src, n);
+            return;
+        }
+#endif
+        BitwiseWordsScalar<Op>(dst, src, n);
+    }
+
+    // Возвращает число единичных битов в n словах: блоками AVX2, инструкцией popcnt
+    // или без них в зависимости от процессора
+    inline size_t PopCountWords(const BitWord* words, size_t n) noexcept {
+#if SIMPLE_VECTOR_X86_SIMD
+        if (DetectSimdLevel() == SimdLevel::kAvx2) {
+            return PopCountWordsAvx2(words, n);
+        }
+        if (HasPopcnt()) {
+            return PopCountWordsPopcnt(words, n);
+        }
+#endif
+        return PopCountWordsScalar(words, n);
+    }
+
+}
+
+// Вектор битов, упакованных по 64 в слова SimpleVector<uint64_t>: занимает в 8 раз меньше памяти,
+// чем SimpleVector<bool>. Интерфейс повторяет SimpleVector, где это возможно: operator[] и итераторы
+// неконстантного вектора возвращают прокси-ссылку Reference, константного — bool.
+// Изменение размера, заполнение, подсчет единиц, поиск и побитовые операции между векторами
+// выполняются по словам. Биты последнего слова за пределами размера всегда нулевые
+class BitVector {
+    using Word = detail::BitWord;
+
+    static constexpr size_t kWordBits = detail::kBitsPerWord;
+
+public:
+    // Ссылка на бит вектора
+    class Reference {
+    public:
+        Reference(const Reference&) noexcept = default;
+
+        Reference& operator=(bool value) noexcept {
+            *word_ = (*word_ & ~mask_) | (-static_cast<Word>(value) & mask_);
+            return *this;
+        }
+
+        Reference& operator=(const Reference& other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+
+        operator bool() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+
+        // Инвертирует бит
+        void Flip() noexcept {
+            *word_ ^= mask_;
+        }
+
+    private:
+        friend class BitVector;
+
+        Reference(Word* word, Word mask) noexcept : word_(word), mask_(mask) {
+        }
+
+        Word* word_;
+        Word mask_;
+    };
+
+private:
+    // Итератор произвольного доступа, хранящий вектор и индекс бита
+    template <typename Owner, typename ReferenceType>
+    class BasicIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ReferenceType;
+
+        BasicIterator() = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept : owner_(owner), index_(index) {
+        }
+
+        // Неконстантный итератор преобразуется в константный
+        template <typename OtherOwner, typename OtherReference,
+            typename = std::enable_if_t<std::is_convertible_v<OtherOwner*, Owner*>>>
+        BasicIterator(const BasicIterator<OtherOwner, OtherReference>& other) noexcept
+            : owner_(other.owner_), index_(other.index_) {
+        }
+
+        // Возвращает индекс бита, на который указывает итератор
+        size_t GetIndex() const noexcept {
+            return index_;
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return (*owner_)[index_ + offset];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy(*this);
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy(*this);
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        template <typename, typename>
+        friend class BasicIterator;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<BitVector, Reference>;
+    using ConstIterator = BasicIterator<const BitVector, bool>;
+
+    // Значение, которое возвращают методы поиска, если бит не найден
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    BitVector() noexcept = default;
+
+    // Создает вектор из size битов со значением value
+    explicit BitVector(size_t size, bool value = false) {
+        Resize(size, value);
+    }
+
+    BitVector(std::initializer_list<bool> init) {
+        Reserve(init.size());
+        for (const bool value : init) {
+            PushBack(value);
+        }
+    }
+
+    BitVector(const BitVector&) = default;
+    BitVector& operator=(const BitVector&) = default;
+
+    BitVector(BitVector&& other) noexcept : words_(std::move(other.words_)), size_(std::exchange(other.size_, 0)) {
+    }
+
+    BitVector& operator=(BitVector&& rhs) noexcept {
+        if (this != &rhs) {
+            words_ = std::move(rhs.words_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    // Возвращает количество битов в векторе
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость вектора в битах
+    size_t GetCapacity() const noexcept {
+        return words_.GetCapacity() * kWordBits;
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает ссылку на бит с индексом index
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Reference(words_.begin() + index / kWordBits, Word{ 1 } << (index % kWordBits));
+    }
+
+    // Возвращает значение бита с индексом index
+    bool operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return (words_[index / kWordBits] >> (index % kWordBits)) & 1;
+    }
+
+    // Возвращает ссылку на бит с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Reference At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("index is out of range");
+        }
+        return (*this)[index];
+    }
+
+    bool At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index is out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Добавляет бит в конец вектора
+    void PushBack(bool value) {
+        if (size_ % kWordBits == 0) {
+            words_.PushBack(0);
+        }
+        words_[size_ / kWordBits] |= static_cast<Word>(value) << (size_ % kWordBits);
+        ++size_;
+    }
+
+    // Добавляет в конец младшие count битов слова bits (count <= 64) одной-двумя операциями над словами
+    void AppendBits(uint64_t bits, size_t count = kWordBits) {
+        assert(count <= kWordBits);
+        if (count == 0) {
+            return;
+        }
+        if (count < kWordBits) {
+            bits &= (Word{ 1 } << count) - 1;
+        }
+        const size_t offset = size_ % kWordBits;
+        if (offset == 0) {
+            words_.PushBack(bits);
+        }
+        else {
+            words_[size_ / kWordBits] |= bits << offset;
+            if (offset + count > kWordBits) {
+                words_.PushBack(bits >> (kWordBits - offset));
+            }
+        }
+        size_ += count;
+    }
+
+    // Удаляет последний бит вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        if (size_ % kWordBits == 0) {
+            words_.PopBack();
+        }
+        else {
+            ClearTail_();
+        }
+    }
+
+    // Обнуляет размер вектора, не изменяя его вместимость
+    void Clear() noexcept {
+        words_.Clear();
+        size_ = 0;
+    }
+
+    // Изменяет размер вектора. Новые биты получают значение value
+    void Resize(size_t new_size, bool value = false) {
+        const size_t old_size = size_;
+        // Новые слова создаются нулевыми, а хвост последнего слова уже обнулен
+        words_.Resize(WordCount_(new_size));
+        size_ = new_size;
+        if (new_size < old_size) {
+            ClearTail_();
+        }
+        else if (value) {
+            SetRange_(old_size, new_size);
+        }
+    }
+
+    // Резервирует память под capacity битов
+    void Reserve(size_t capacity) {
+        words_.Reserve(WordCount_(capacity));
+    }
+
+    // Уменьшает вместимость до размера вектора
+    void ShrinkToFit() {
+        words_.ShrinkToFit();
+    }
+
+    // Присваивает всем битам значение value
+    void Fill(bool value) noexcept {
+        std::fill(words_.begin(), words_.end(), value ? ~Word{ 0 } : Word{ 0 });
+        ClearTail_();
+    }
+
+    // Инвертирует все биты
+    void Flip() noexcept {
+        for (Word& word : words_) {
+            word = ~word;
+        }
+        ClearTail_();
+    }
+
+    // Возвращает количество единичных битов
+    size_t Count() const noexcept {
+        return detail::PopCountWords(words_.begin(), words_.GetSize());
+    }
+
+    // Сообщает, есть ли единичные биты
+    bool Any() const noexcept {
+        return std::any_of(words_.begin(), words_.end(), [](Word word) {
+            return word != 0;
+        });
+    }
+
+    // Сообщает, все ли биты единичные. Для пустого вектора возвращает true
+    bool All() const noexcept {
+        return Count() == size_;
+    }
+
+    bool None() const noexcept {
+        return !Any();
+    }
+
+    // Возвращает индекс первого единичного бита или npos
+    size_t FindFirst() const noexcept {
+        return FindNext(0);
+    }
+
+    // Возвращает индекс первого единичного бита, не меньший from, или npos
+    size_t FindNext(size_t from) const noexcept {
+        if (from >= size_) {
+            return npos;
+        }
+        size_t index = from / kWordBits;
+        Word word = words_[index] & (~Word{ 0 } << (from % kWordBits));
+        while (word == 0) {
+            if (++index == words_.GetSize()) {
+                return npos;
+            }
+            word = words_[index];
+        }
+        return index * kWordBits + detail::CountTrailingZeros(word);
+    }
+
+    // Побитовые операции с вектором того же размера.
+    // Выбрасывают исключение std::invalid_argument, если размеры различаются
+    BitVector& operator&=(const BitVector& rhs) {
+        return Apply_<detail::BitOp::kAnd>(rhs);
+    }
+
+    BitVector& operator|=(const BitVector& rhs) {
+        return Apply_<detail::BitOp::kOr>(rhs);
+    }
+
+    BitVector& operator^=(const BitVector& rhs) {
+        return Apply_<detail::BitOp::kXor>(rhs);
+    }
+
+    // Возвращает вектор с инвертированными битами
+    BitVector operator~() const {
+        BitVector result(*this);
+        result.Flip();
+        return result;
+    }
+
+    // Возвращает слова, в которые упакованы биты: бит i хранится в разряде i % 64 слова i / 64
+    SimpleVectorView<const uint64_t> GetWords() const noexcept {
+        return SimpleVectorView<const uint64_t>(words_.begin(), words_.GetSize());
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    void swap(BitVector& other) noexcept {
+        words_.swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    SimpleVector<Word> words_;
+    size_t size_ = 0;
+
+    static size_t WordCount_(size_t bits) noexcept {
+        return bits / kWordBits + (bits % kWordBits != 0 ? 1 : 0);
+    }
+
+    // Обнуляет биты последнего слова за пределами размера
+    void ClearTail_() noexcept {
+        if (size_ % kWordBits != 0) {
+            words_[size_ / kWordBits] &= (Word{ 1 } << (size_ % kWordBits)) - 1;
+        }
+    }
+
+    // Устанавливает биты [first, last): крайние слова по маске, остальные целиком
+    void SetRange_(size_t first, size_t last) noexcept {
+        if (first == last) {
+            return;
+        }
+        const size_t first_word = first / kWordBits;
+        const size_t last_word = (last - 1) / kWordBits;
+        const Word first_mask = ~Word{ 0 } << (first % kWordBits);
+        const Word last_mask = ~Word{ 0 } >> (kWordBits - 1 - (last - 1) % kWordBits);
+        if (first_word == last_word) {
+            words_[first_word] |= first_mask & last_mask;
+            return;
+        }
+        words_[first_word] |= first_mask;
+        std::fill(words_.begin() + first_word + 1, words_.begin() + last_word, ~Word{ 0 });
+        words_[last_word] |= last_mask;
+    }
+
+    template <detail::BitOp Op>
+    BitVector& Apply_(const BitVector& rhs) {
+        if (size_ != rhs.size_) {
+            throw std::invalid_argument("bit vectors have different sizes");
+        }
+        detail::BitwiseWords<Op>(words_.begin(), rhs.words_.begin(), words_.GetSize());
+        return *this;
+    }
+};
+
+inline BitVector operator&(BitVector lhs, const BitVector& rhs) {
+    return lhs &= rhs;
+}
+
+inline BitVector operator|(BitVector lhs, const BitVector& rhs) {
+    return lhs |= rhs;
+}
+
+inline BitVector operator^(BitVector lhs, const BitVector& rhs) {
+    return lhs ^= rhs;
+}
+
+inline bool operator==(const BitVector& lhs, const BitVector& rhs) {
+    const auto lhs_words = lhs.GetWords();
+    return lhs.GetSize() == rhs.GetSize() && detail::RangesEqual(lhs_words.Data(), rhs.GetWords().Data(), lhs_words.GetSize());
+}
+
+inline bool operator!=(const BitVector& lhs, const BitVector& rhs) {
+    return !(lhs == rhs);
+}
+
+// Лексикографическое сравнение, как у SimpleVector<bool>: различие ищется по словам,
+// а решает младший различающийся бит первого различающегося слова
+inline bool operator<(const BitVector& lhs, const BitVector& rhs) {
+    const auto lhs_words = lhs.GetWords();
+    const auto rhs_words = rhs.GetWords();
+    const size_t common = std::min(lhs.GetSize(), rhs.GetSize());
+    const size_t words = (common + detail::kBitsPerWord - 1) / detail::kBitsPerWord;
+    for (size_t i = 0; i < words; ++i) {
+        const uint64_t difference = lhs_words[i] ^ rhs_words[i];
+        if (difference != 0) {
+            const size_t bit = detail::CountTrailingZeros(difference);
+            if (i * detail::kBitsPerWord + bit >= common) {
+                break;
+            }
+            return (rhs_words[i] >> bit) & 1;
+        }
+    }
+    return lhs.GetSize() < rhs.GetSize();
+}
+
+inline bool operator>(const BitVector& lhs, const BitVector& rhs) {
+    return rhs < lhs;
+}
+
+inline bool operator<=(const BitVector& lhs, const BitVector& rhs) {
+    return !(lhs > rhs);
+}
+
+inline bool operator>=(const BitVector& lhs, const BitVector& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "constexpr_support.h"
+
+// Векторные ядра сравнения доступны при сборке GCC/Clang под x86 с SSE2
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMPLE_VECTOR_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define SIMPLE_VECTOR_X86_SIMD 0
+#endif
+
+// Ядра сравнения диапазонов для операторов сравнения векторов.
+// Для целых и плавающих элементов различие ищется блоками SSE2 или AVX2 (набор выбирается во время выполнения),
+// на остальных платформах и для остальных типов используются скалярные алгоритмы с той же семантикой
+namespace detail {
+
+    enum class SimdLevel {
+        kScalar,
+        kSse2,
+        kAvx2,
+    };
+
+    // Возвращает наилучший набор векторных инструкций, поддерживаемый процессором
+    inline SimdLevel DetectSimdLevel() noexcept {
+#if SIMPLE_VECTOR_X86_SIMD
+        static const SimdLevel level = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? SimdLevel::kAvx2 : SimdLevel::kSse2;
+        }();
+        return level;
+#else
+        return SimdLevel::kScalar;
+#endif
+    }
+
+    // Элементы, для которых предусмотрены векторные ядра
+    template <typename Type>
+    inline constexpr bool IsSimdComparableV = std::is_integral_v<Type>
+        || std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+    // Возвращает индекс первой пары различающихся элементов или n, если различий нет.
+    // При Ordered == false различием считается !(a == b), то есть NaN отличается от всего, включая себя;
+    // при Ordered == true — a < b || b < a, как в std::lexicographical_compare, и пары с NaN пропускаются
+    template <bool Ordered, typename Type>
+    size_t MismatchScalar(const Type* a, const Type* b, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            if (Ordered ? (a[i] < b[i] || b[i] < a[i]) : !(a[i] == b[i])) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+#if SIMPLE_VECTOR_X86_SIMD
+
+    // Возвращает смещение первого различающегося байта или bytes, если блоки совпадают
+    inline size_t MismatchBytesSse2(const unsigned char* a, const unsigned char* b, size_t bytes) noexcept {
+        size_t i = 0;
+        for (; i + 16 <= bytes; i += 16) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xFFFFu;
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        for (; i < bytes && a[i] == b[i]; ++i) {
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    inline size_t MismatchBytesAvx2(const unsigned char* a, const unsigned char* b, size_t bytes) noexcept {
+        size_t i = 0;
+        for (; i + 32 <= bytes; i += 32) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + MismatchBytesSse2(a + i, b + i, bytes - i);
+    }
+
+    // Сравнения с упорядоченными предикатами: с NaN ни одно из них не выполняется
+    template <bool Ordered>
+    size_t MismatchSse2(const float* a, const float* b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128 x = _mm_loadu_ps(a + i);
+            const __m128 y = _mm_loadu_ps(b + i);
+            const unsigned mask = Ordered
+                ? static_cast<unsigned>(_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(x, y), _mm_cmpgt_ps(x, y))))
+                : static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(x, y))) ^ 0xFu;
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + MismatchScalar<Ordered>(a + i, b + i, n - i);
+    }
+
+    template <bool Ordered>
+    size_t MismatchSse2(const double* a, const double* b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d x = _mm_loadu_pd(a + i);
+            const __m128d y = _mm_loadu_pd(b + i);
+            const unsigned mask = Ordered
+                ? static_cast<unsigned>(_mm_movemask_pd(_mm_or_pd(_mm_cmplt_pd(x, y), _mm_cmpgt_pd(x, y))))
+                : static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(x, y))) ^ 0x3u;
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + MismatchScalar<Ordered>(a + i, b + i, n - i);
+    }
+
+    template <bool Ordered>
+    __attribute__((target("avx2")))
+    size_t MismatchAvx2(const float* a, const float* b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256 x = _mm256_loadu_ps(a + i);
+            const __m256 y = _mm256_loadu_ps(b + i);
+            const unsigned mask = Ordered
+                ? static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(x, y, _CMP_NEQ_OQ)))
+                : static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(x, y, _CMP_EQ_OQ))) ^ 0xFFu;
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + MismatchSse2<Ordered>(a + i, b + i, n - i);
+    }
+
+    template <bool Ordered>
+    __attribute__((target("avx2")))
+    size_t MismatchAvx2(const double* a, const double* b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d x = _mm256_loadu_pd(a + i);
+            const __m256d y = _mm256_loadu_pd(b + i);
+            const unsigned mask = Ordered
+                ? static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(x, y, _CMP_NEQ_OQ)))
+                : static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(x, y, _CMP_EQ_OQ))) ^ 0xFu;
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + MismatchSse2<Ordered>(a + i, b + i, n - i);
+    }
+
+#endif
+
+    // Возвращает индекс первой пары различающихся элементов (см. MismatchScalar) или n,
+    // используя векторные инструкции уровня не выше level
+    template <bool Ordered, typename Type>
+    size_t FindMismatch(const Type* a, const Type* b, size_t n, SimdLevel level = DetectSimdLevel()) noexcept {
+        static_assert(IsSimdComparableV<Type>, "Type must be integral, float or double");
+#if SIMPLE_VECTOR_X86_SIMD
+        if (level != SimdLevel::kScalar) {
+            if constexpr (std::is_integral_v<Type>) {
+                // Первый различающийся байт принадлежит первому различающемуся элементу
+                const auto* a_bytes = reinterpret_cast<const unsigned char*>(a);
+                const auto* b_bytes = reinterpret_cast<const unsigned char*>(b);
+                const size_t bytes = n * sizeof(Type);
+                const size_t offset = level == SimdLevel::kAvx2
+                    ? MismatchBytesAvx2(a_bytes, b_bytes, bytes)
+                    : MismatchBytesSse2(a_bytes, b_bytes, bytes);
+                return offset / sizeof(Type);
+            }
+            else {
+                return level == SimdLevel::kAvx2 ? MismatchAvx2<Ordered>(a, b, n) : MismatchSse2<Ordered>(a, b, n);
+            }
+        }
+#else
+        (void)level;
+#endif
+        return MismatchScalar<Ordered>(a, b, n);
+    }
+
+    // Сравнивает n элементов a и b на равенство с семантикой std::equal.
+    // Целые элементы сравниваются побайтово через memcmp, в константных выражениях - поэлементно
+    template <typename Type>
+    SIMPLE_VECTOR_CONSTEXPR bool RangesEqual(const Type* a, const Type* b, size_t n) {
+        if (IsConstantEvaluated()) {
+            return std::equal(a, a + n, b);
+        }
+        if constexpr (std::is_integral_v<Type>) {
+            return n == 0 || std::memcmp(a, b, n * sizeof(Type)) == 0;
+        }
+        else if constexpr (IsSimdComparableV<Type>) {
+            return FindMismatch<false>(a, b, n) == n;
+        }
+        else {
+            return std::equal(a, a + n, b);
+        }
+    }
+
+    // Лексикографически сравнивает диапазоны с семантикой std::lexicographical_compare
+    template <typename Type>
+    SIMPLE_VECTOR_CONSTEXPR bool RangesLess(const Type* a, size_t a_size, const Type* b, size_t b_size) {
+        if (IsConstantEvaluated()) {
+            return std::lexicographical_compare(a, a + a_size, b, b + b_size);
+        }
+        if constexpr (IsSimdComparableV<Type>) {
+            const size_t n = std::min(a_size, b_size);
+            const size_t i = FindMismatch<true>(a, b, n);
+            return i < n ? a[i] < b[i] : a_size < b_size;
+        }
+        else {
+            return std::lexicographical_compare(a, a + a_size, b, b + b_size);
+        }
+    }
+
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "malloc_allocator.h"
+#include "segment_index.h"
+
+// Вектор с конкурентным добавлением элементов из многих потоков без блокировок.
+// Элементы хранятся в сегментах геометрически растущего размера, которые не перемещаются при росте,
+// поэтому адреса опубликованных элементов остаются действительными до разрушения вектора.
+// Добавление атомарно резервирует индекс, создает элемент в его ячейке и публикует ячейку флагом готовности.
+// Читатели могут обращаться к опубликованным элементам одновременно с добавлением.
+// Флаг готовности хранится в каждой ячейке рядом с элементом, поэтому из-за выравнивания
+// для 8-байтовых типов (size_t, double, указатели) вектор занимает вдвое больше памяти, чем SimpleVector.
+// Разрушение вектора и Clear требуют, чтобы другие потоки не обращались к вектору
+template <typename Type, typename Allocator = MallocAllocator<Type>, size_t FirstSegmentSize = 64>
+class ConcurrentSimpleVector {
+    // Ячейка для элемента с флагом публикации
+    struct Slot {
+        std::atomic<bool> ready{ false };
+        alignas(Type) unsigned char storage[sizeof(Type)];
+
+        Type* Get() noexcept {
+            return std::launder(reinterpret_cast<Type*>(storage));
+        }
+    };
+
+    using Index = detail::SegmentIndex<FirstSegmentSize>;
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using SlotAllocatorTraits = std::allocator_traits<SlotAllocator>;
+
+public:
+    ConcurrentSimpleVector() = default;
+
+    explicit ConcurrentSimpleVector(const Allocator& alloc) : alloc_(alloc) {
+    }
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector() {
+        Clear();
+        for (size_t segment = 0; segment < Index::kMaxSegments; ++segment) {
+            if (Slot* slots = segments_[segment].load(std::memory_order_relaxed)) {
+                SlotAllocatorTraits::deallocate(alloc_, slots, Index::SegmentSize(segment));
+            }
+        }
+    }
+
+    // Добавляет элемент в конец вектора. Потокобезопасно.
+    // Возвращает индекс добавленного элемента
+    size_t PushBack(const Type& item) {
+        return Emplace_(item).first;
+    }
+
+    size_t PushBack(Type&& item) {
+        return Emplace_(std::move(item)).first;
+    }
+
+    // Создает элемент в конце вектора из аргументов args. Потокобезопасно.
+    // Если конструктор выбросит исключение, зарезервированный индекс останется неопубликованным
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *Emplace_(std::forward<Args>(args)...).second;
+    }
+
+    // Заранее выделяет сегменты под capacity элементов. Потокобезопасно
+    void Reserve(size_t capacity) {
+        for (size_t segment = 0; segment < Index::SegmentCount(capacity); ++segment) {
+            Segment_(segment);
+        }
+    }
+
+    // Возвращает количество зарезервированных индексов, включая еще не опубликованные элементы
+    size_t GetSize() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Сообщает, опубликован ли элемент с индексом index
+    bool IsPublished(size_t index) const noexcept {
+        return Find_(index) != nullptr;
+    }
+
+    // Возвращает указатель на опубликованный элемент с индексом index или nullptr, если он еще не опубликован
+    Type* TryGet(size_t index) noexcept {
+        return Find_(index);
+    }
+
+    const Type* TryGet(size_t index) const noexcept {
+        return Find_(index);
+    }
+
+    // Возвращает ссылку на элемент с индексом index. Элемент должен быть опубликован
+    Type& operator[](size_t index) noexcept {
+        Type* item = Find_(index);
+        assert(item);
+        return *item;
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        const Type* item = Find_(index);
+        assert(item);
+        return *item;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если элемент не опубликован
+    Type& At(size_t index) {
+        Type* item = Find_(index);
+        if (!item) {
+            throw std::out_of_range("index is out of range");
+        }
+        return *item;
+    }
+
+    const Type& At(size_t index) const {
+        const Type* item = Find_(index);
+        if (!item) {
+            throw std::out_of_range("index is out of range");
+        }
+        return *item;
+    }
+
+    // Разрушает элементы, сохраняя выделенные сегменты. Не потокобезопасно
+    void Clear() noexcept {
+        const size_t size = size_.load(std::memory_order_relaxed);
+        for (size_t segment = 0; segment < Index::SegmentCount(size); ++segment) {
+            Slot* slots = segments_[segment].load(std::memory_order_relaxed);
+            if (!slots) {
+                continue;
+            }
+            const size_t count = std::min(Index::SegmentSize(segment), size - Index::SegmentBegin(segment));
+            for (size_t i = 0; i < count; ++i) {
+                if (slots[i].ready.load(std::memory_order_relaxed)) {
+                    std::destroy_at(slots[i].Get());
+                    slots[i].ready.store(false, std::memory_order_relaxed);
+                }
+            }
+        }
+        size_.store(0, std::memory_order_relaxed);
+    }
+
+    // Возвращает копию аллокатора
+    Allocator GetAllocator() const noexcept {
+        return Allocator(alloc_);
+    }
+
+private:
+    [[no_unique_address]] SlotAllocator alloc_;
+    std::atomic<size_t> size_{ 0 };
+    // Таблица сегментов фиксированного размера: ее элементы только переходят от nullptr к выделенному сегменту
+    std::array<std::atomic<Slot*>, Index::kMaxSegments> segments_{};
+
+    // Возвращает сегмент с номером segment, выделяя его при необходимости. Не блокирует другие потоки:
+    // если несколько потоков выделили сегмент одновременно, сохраняется первый, а остальные освобождаются
+    Slot* Segment_(size_t segment) {
+        Slot* slots = segments_[segment].load(std::memory_order_acquire);
+        if (slots) {
+            return slots;
+        }
+
+        const size_t count = Index::SegmentSize(segment);
+        Slot* fresh = SlotAllocatorTraits::allocate(alloc_, count);
+        std::uninitialized_default_construct_n(fresh, count);
+        if (segments_[segment].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return fresh;
+        }
+        SlotAllocatorTraits::deallocate(alloc_, fresh, count);
+        return slots;
+    }
+
+    // Возвращает опубликованный элемент с индексом index или nullptr
+    Type* Find_(size_t index) const noexcept {
+        if (index >= GetSize()) {
+            return nullptr;
+        }
+        const auto position = Index::Locate(index);
+        Slot* slots = segments_[position.segment].load(std::memory_order_acquire);
+        if (!slots || !slots[position.offset].ready.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return slots[position.offset].Get();
+    }
+
+    // Резервирует индекс, создает в его ячейке элемент из аргументов args и публикует его
+    template <typename... Args>
+    std::pair<size_t, Type*> Emplace_(Args&&... args) {
+        const size_t index = size_.fetch_add(1, std::memory_order_acq_rel);
+        const auto position = Index::Locate(index);
+        assert(position.segment < Index::kMaxSegments);
+
+        Slot& slot = Segment_(position.segment)[position.offset];
+        Type* item = new (slot.storage) Type(std::forward<Args>(args)...);
+        slot.ready.store(true, std::memory_order_release);
+
+        // Следующий сегмент заранее выделяет один поток, занявший середину текущего, поэтому потоки,
+        // дошедшие до нового сегмента, обычно находят его готовым и не выделяют лишних копий.
+        // Элемент уже опубликован, поэтому нехватка памяти здесь не ошибка: сегмент выделит первый поток,
+        // которому он понадобится
+        if (position.offset == Index::SegmentSize(position.segment) / 2 && position.segment + 1 < Index::kMaxSegments) {
+            try {
+                Segment_(position.segment + 1);
+            }
+            catch (const std::bad_alloc&) {
+            }
+        }
+        return { index, item };
+    }
+};
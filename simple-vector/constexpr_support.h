@@ -0,0 +1,102 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+// SimpleVector и ArrayPtr пригодны для константных выражений, если компилятор и стандартная библиотека
+// поддерживают выделение памяти в constexpr (C++20): память в константном выражении выделяется
+// через std::allocator, а элементы создаются std::construct_at. В C++17 макрос SIMPLE_VECTOR_CONSTEXPR пуст
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc) \
+    && defined(__cpp_lib_is_constant_evaluated)
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 1
+#define SIMPLE_VECTOR_CONSTEXPR constexpr
+#else
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 0
+#define SIMPLE_VECTOR_CONSTEXPR
+#endif
+
+namespace detail {
+
+    // Сообщает, вычисляется ли вызов в константном выражении. Без поддержки constexpr всегда false
+    constexpr bool IsConstantEvaluated() noexcept {
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+        return std::is_constant_evaluated();
+#else
+        return false;
+#endif
+    }
+
+    // Создает объект в неинициализированной памяти p, как placement new
+    template <typename Type, typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type* ConstructAt(Type* p, Args&&... args) {
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+        return std::construct_at(p, std::forward<Args>(args)...);
+#else
+        return ::new (static_cast<void*>(p)) Type(std::forward<Args>(args)...);
+#endif
+    }
+
+    // Аналоги std::uninitialized_*, допустимые в константных выражениях: при вычислении
+    // константного выражения элементы создаются по одному через ConstructAt, иначе вызываются
+    // алгоритмы стандартной библиотеки. Исключение в константном выражении делает его ошибочным,
+    // поэтому откат созданных элементов нужен только во время выполнения
+
+    template <typename InputIt, typename Type>
+    SIMPLE_VECTOR_CONSTEXPR Type* UninitializedCopy(InputIt first, InputIt last, Type* dest) {
+        if (IsConstantEvaluated()) {
+            for (; first != last; ++first, ++dest) {
+                ConstructAt(dest, *first);
+            }
+            return dest;
+        }
+        return std::uninitialized_copy(first, last, dest);
+    }
+
+    // Перемещает элементы [first, last) в неинициализированную память dest, как std::move_if_noexcept:
+    // элементы, конструктор перемещения которых может выбросить исключение, копируются, если это возможно.
+    // Тогда при исключении созданные элементы разрушаются, а исходный диапазон остается прежним
+    template <typename Type>
+    SIMPLE_VECTOR_CONSTEXPR Type* UninitializedMoveIfNoexcept(Type* first, Type* last, Type* dest) {
+        if (IsConstantEvaluated()) {
+            for (; first != last; ++first, ++dest) {
+                ConstructAt(dest, std::move_if_noexcept(*first));
+            }
+            return dest;
+        }
+        if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+            return std::uninitialized_move(first, last, dest);
+        }
+        else {
+            return std::uninitialized_copy(first, last, dest);
+        }
+    }
+
+    template <typename Type>
+    SIMPLE_VECTOR_CONSTEXPR Type* UninitializedFillN(Type* dest, size_t count, const Type& value) {
+        if (IsConstantEvaluated()) {
+            for (; count != 0; --count, ++dest) {
+                ConstructAt(dest, value);
+            }
+            return dest;
+        }
+        return std::uninitialized_fill_n(dest, count, value);
+    }
+
+    template <typename Type>
+    SIMPLE_VECTOR_CONSTEXPR Type* UninitializedValueConstructN(Type* dest, size_t count) {
+        if (IsConstantEvaluated()) {
+            for (; count != 0; --count, ++dest) {
+                ConstructAt(dest);
+            }
+            return dest;
+        }
+        return std::uninitialized_value_construct_n(dest, count);
+    }
+
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Вектор с копированием при записи. Копии разделяют один буфер SimpleVector со счетчиком ссылок
+// (std::shared_ptr, потокобезопасный подсчет), поэтому копирование и присваивание стоят O(1).
+// Первый изменяющий вызов на разделяемом векторе (неконстантные operator[], At, begin/end, PushBack,
+// Insert, Erase, Resize и т. д.) отделяет его, копируя элементы в собственный буфер.
+// Ссылки и итераторы, полученные до отделения, продолжают указывать на общий буфер.
+// Как в реализациях std::string с копированием при записи, буфер, на элементы которого выданы
+// изменяемые ссылки или итераторы, становится неразделяемым: следующая копия получает собственный буфер,
+// чтобы запись по старой ссылке не изменила копию. Выдачей считаются неконстантные operator[], At,
+// begin/end, а также EmplaceBack, Insert, Emplace и Erase, возвращающие ссылку или итератор.
+// Разные экземпляры, разделяющие буфер, можно использовать из разных потоков без синхронизации
+template <typename Type, typename Allocator = MallocAllocator<Type>>
+class CowSimpleVector {
+    using Vector = SimpleVector<Type, Allocator>;
+
+public:
+    using Iterator = typename Vector::Iterator;
+    using ConstIterator = typename Vector::ConstIterator;
+
+    CowSimpleVector() noexcept = default;
+
+    // Создает вектор из size элементов, инициализированных значением по умолчанию
+    explicit CowSimpleVector(size_t size) : data_(std::make_shared<Vector>(size)) {
+    }
+
+    // Создает вектор из size элементов, инициализированных значением value
+    CowSimpleVector(size_t size, const Type& value) : data_(std::make_shared<Vector>(size, value)) {
+    }
+
+    // Создает вектор из std::initializer_list
+    CowSimpleVector(std::initializer_list<Type> init) : data_(std::make_shared<Vector>(init)) {
+    }
+
+    // Принимает элементы вектора vector
+    explicit CowSimpleVector(Vector vector) : data_(std::make_shared<Vector>(std::move(vector))) {
+    }
+
+    // Разделяет буфер other, если на его элементы не выданы изменяемые ссылки, иначе копирует элементы
+    CowSimpleVector(const CowSimpleVector& other)
+        : data_(other.unshareable_ ? std::make_shared<Vector>(*other.data_) : other.data_) {
+    }
+
+    CowSimpleVector(CowSimpleVector&& other) noexcept
+        : data_(std::move(other.data_)), unshareable_(std::exchange(other.unshareable_, false)) {
+    }
+
+    CowSimpleVector& operator=(const CowSimpleVector& rhs) {
+        if (this != &rhs) {
+            CowSimpleVector copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    CowSimpleVector& operator=(CowSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            CowSimpleVector moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    // Сообщает, разделяет ли вектор буфер с другими копиями
+    bool IsShared() const noexcept {
+        return data_ && data_.use_count() > 1;
+    }
+
+    // Заранее отделяет вектор от других копий, чтобы последующие изменения не копировали буфер
+    void Detach() {
+        Mutable_();
+    }
+
+    // Возвращает константную ссылку на общий вектор
+    const Vector& Get() const noexcept {
+        return data_ ? *data_ : Empty_();
+    }
+
+    // Добавляет элемент в конец вектора
+    void PushBack(const Type& item) {
+        Mutable_().PushBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        Mutable_().PushBack(std::move(item));
+    }
+
+    // Создает элемент в конце вектора из аргументов args
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return Exposed_().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Вставляет элемент в указанной позиции. pos может указывать в общий буфер
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        const size_t index = pos - cbegin();
+        Vector& vector = Exposed_();
+        return vector.Insert(vector.cbegin() + index, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        const size_t index = pos - cbegin();
+        Vector& vector = Exposed_();
+        return vector.Insert(vector.cbegin() + index, std::move(value));
+    }
+
+    // Создает элемент в указанной позиции из аргументов args. pos может указывать в общий буфер
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        const size_t index = pos - cbegin();
+        Vector& vector = Exposed_();
+        return vector.Emplace(vector.cbegin() + index, std::forward<Args>(args)...);
+    }
+
+    // Удаляет последний элемент вектора
+    void PopBack() {
+        Mutable_().PopBack();
+    }
+
+    // Удаляет элемент вектора в указанной позиции. pos может указывать в общий буфер
+    Iterator Erase(ConstIterator pos) {
+        const size_t index = pos - cbegin();
+        Vector& vector = Exposed_();
+        return vector.Erase(vector.cbegin() + index);
+    }
+
+    // Удаляет элементы вектора в диапазоне [first, last). Итераторы могут указывать в общий буфер
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t first_index = first - cbegin();
+        const size_t last_index = last - cbegin();
+        Vector& vector = Exposed_();
+        return vector.Erase(vector.cbegin() + first_index, vector.cbegin() + last_index);
+    }
+
+    // Обнуляет размер вектора. Разделяемый буфер не копируется, а отпускается.
+    // Выданные ссылки на элементы становятся недействительными, поэтому буфер снова можно разделять
+    void Clear() noexcept {
+        if (IsShared()) {
+            data_.reset();
+        }
+        else if (data_) {
+            data_->Clear();
+        }
+        unshareable_ = false;
+    }
+
+    // Изменяет размер вектора
+    void Resize(size_t new_size) {
+        Mutable_().Resize(new_size);
+    }
+
+    // Изменяет вместимость вектора
+    void Reserve(size_t new_capacity) {
+        Mutable_().Reserve(new_capacity);
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(CowSimpleVector& other) noexcept {
+        data_.swap(other.data_);
+        std::swap(unshareable_, other.unshareable_);
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t GetSize() const noexcept {
+        return Get().GetSize();
+    }
+
+    // Возвращает вместимость вектора
+    size_t GetCapacity() const noexcept {
+        return Get().GetCapacity();
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return Get().IsEmpty();
+    }
+
+    // Возвращает ссылку на элемент с индексом index, отделяя вектор
+    Type& operator[](size_t index) {
+        return Exposed_()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        return Get()[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index, отделяя вектор
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        Get().At(index);
+        return Exposed_()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        return Get().At(index);
+    }
+
+    // Возвращает итератор на начало вектора, отделяя вектор
+    Iterator begin() {
+        return Exposed_().begin();
+    }
+
+    // Возвращает итератор на элемент, следующий за последним, отделяя вектор
+    Iterator end() {
+        return Exposed_().end();
+    }
+
+    ConstIterator begin() const noexcept {
+        return Get().begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return Get().end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return Get().cbegin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return Get().cend();
+    }
+
+private:
+    // Общий буфер. nullptr означает пустой вектор
+    std::shared_ptr<Vector> data_;
+    // Выданы ли изменяемые ссылки или итераторы на элементы буфера
+    bool unshareable_ = false;
+
+    static const Vector& Empty_() noexcept {
+        static const Vector empty;
+        return empty;
+    }
+
+    // Возвращает вектор, принадлежащий только этому экземпляру, копируя общий буфер при необходимости
+    Vector& Mutable_() {
+        if (!data_) {
+            data_ = std::make_shared<Vector>();
+        }
+        else if (data_.use_count() > 1) {
+            data_ = std::make_shared<Vector>(*data_);
+        }
+        else {
+            // Другие владельцы могли только что отпустить буфер: их чтения должны предшествовать нашим записям
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *data_;
+    }
+
+    // Как Mutable_, но помечает буфер неразделяемым, так как вызывающий выдает ссылку на его элементы
+    Vector& Exposed_() {
+        Vector& vector = Mutable_();
+        unshareable_ = true;
+        return vector;
+    }
+};
+
+template <typename Type, typename Allocator>
+inline bool operator==(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return lhs.Get() == rhs.Get();
+}
+
+template <typename Type, typename Allocator>
+inline bool operator!=(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator>
+inline bool operator<(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return lhs.Get() < rhs.Get();
+}
+
+template <typename Type, typename Allocator>
+inline bool operator>(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator>
+inline bool operator<=(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <typename Type, typename Allocator>
+inline bool operator>=(const CowSimpleVector<Type, Allocator>& lhs, const CowSimpleVector<Type, Allocator>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,385 @@
+#pragma once
+
+#include "sorted_simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace detail {
+
+    // Сравнивает пары ключ-значение FlatMap по ключам, а также пары с ключами поиска
+    template <typename Key, typename Value, typename Compare>
+    struct PairKeyCompare {
+        Compare comp;
+
+        bool operator()(const std::pair<Key, Value>& lhs, const std::pair<Key, Value>& rhs) const {
+            return comp(lhs.first, rhs.first);
+        }
+
+        template <typename Other>
+        bool operator()(const std::pair<Key, Value>& lhs, const Other& rhs) const {
+            return comp(lhs.first, rhs);
+        }
+
+        template <typename Other>
+        bool operator()(const Other& lhs, const std::pair<Key, Value>& rhs) const {
+            return comp(lhs, rhs.first);
+        }
+    };
+
+    // Итератор FlatMap по изменяемым значениям. Разыменование дает пару ссылок std::pair<const Key&, Value&>,
+    // поэтому через итератор нельзя изменить ключ и нарушить порядок пар
+    template <typename Key, typename Value, typename Compare>
+    class FlatMapIterator {
+        using Base = SortedIterator<std::pair<Key, Value>*, Compare>;
+        using ConstBase = SortedIterator<const std::pair<Key, Value>*, Compare>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, Value&>;
+
+        // Результат operator->: хранит пару ссылок, на которую указывает
+        class pointer {
+        public:
+            explicit pointer(reference ref) noexcept : ref_(ref) {
+            }
+
+            const reference* operator->() const noexcept {
+                return &ref_;
+            }
+
+        private:
+            reference ref_;
+        };
+
+        FlatMapIterator() noexcept = default;
+
+        explicit FlatMapIterator(Base base) noexcept : base_(base) {
+        }
+
+        // Приводится к константному итератору FlatMap
+        operator ConstBase() const noexcept {
+            return ConstBase(base_);
+        }
+
+        reference operator*() const noexcept {
+            std::pair<Key, Value>& item = *base_;
+            return reference(item.first, item.second);
+        }
+
+        pointer operator->() const noexcept {
+            return pointer(**this);
+        }
+
+        FlatMapIterator& operator++() {
+            ++base_;
+            return *this;
+        }
+
+        FlatMapIterator operator++(int) {
+            FlatMapIterator copy(*this);
+            ++base_;
+            return copy;
+        }
+
+        friend bool operator==(const FlatMapIterator& lhs, const FlatMapIterator& rhs) noexcept {
+            return lhs.base_ == rhs.base_;
+        }
+
+        friend bool operator!=(const FlatMapIterator& lhs, const FlatMapIterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+    private:
+        Base base_;
+    };
+
+}
+
+// Множество уникальных ключей, хранящихся в упорядоченном SimpleVector (см. SortedSimpleVector):
+// вставки накапливаются в буфере на StagingCapacity элементов и сливаются одним проходом,
+// поиск выполняется двоичным поиском без ветвлений. Подходит для таблиц, в которых поиск
+// преобладает над вставками: на большом множестве вставка в среднем стоит O(size / StagingCapacity).
+// Константные методы не изменяют множество, поэтому их можно вызывать из нескольких потоков
+template <typename Key, typename Compare = std::less<Key>, size_t StagingCapacity = 64>
+class FlatSet {
+    using Storage = detail::SortedStorage<Key, Compare, StagingCapacity>;
+
+public:
+    using Iterator = typename Storage::ConstIterator;
+    using ConstIterator = typename Storage::ConstIterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp) : storage_(comp) {
+    }
+
+    // Создает множество из ключей init. Из повторяющихся ключей остается первый
+    FlatSet(std::initializer_list<Key> init, const Compare& comp = Compare()) : storage_(comp) {
+        storage_.Assign(SimpleVector<Key>(init), true);
+    }
+
+    size_t GetSize() const noexcept {
+        return storage_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    void Clear() noexcept {
+        storage_.Clear();
+    }
+
+    // Резервирует память под capacity упорядоченных ключей
+    void Reserve(size_t capacity) {
+        storage_.Reserve(capacity);
+    }
+
+    // Добавляет ключ, если его нет во множестве. Возвращает true, если ключ добавлен
+    bool Insert(const Key& key) {
+        if (Contains(key)) {
+            return false;
+        }
+        storage_.Stage(Key(key));
+        return true;
+    }
+
+    bool Insert(Key&& key) {
+        if (Contains(key)) {
+            return false;
+        }
+        storage_.Stage(std::move(key));
+        return true;
+    }
+
+    // Добавляет ключи [first, last), которых нет во множестве, за одно слияние
+    template <typename InputIterator, typename = detail::RequireInputIterator<InputIterator>>
+    void Insert(InputIterator first, InputIterator last) {
+        storage_.StageRange(first, last, true);
+    }
+
+    template <typename Other>
+    bool Contains(const Other& key) const {
+        return storage_.Find(key) != nullptr;
+    }
+
+    // Возвращает указатель на ключ, равный key, или nullptr.
+    // Указатель действителен до следующего изменения множества
+    template <typename Other>
+    const Key* Find(const Other& key) const {
+        return storage_.Find(key);
+    }
+
+    // Удаляет ключ key. Возвращает true, если ключ был во множестве
+    template <typename Other>
+    bool Erase(const Other& key) {
+        Key* const found = storage_.Find(key);
+        if (found == nullptr) {
+            return false;
+        }
+        storage_.Erase(found);
+        return true;
+    }
+
+    // Сливает накопленные вставки с упорядоченной частью
+    void Flush() {
+        storage_.Merge();
+    }
+
+    ConstIterator begin() const {
+        return storage_.begin();
+    }
+
+    ConstIterator end() const {
+        return storage_.end();
+    }
+
+    ConstIterator cbegin() const {
+        return begin();
+    }
+
+    ConstIterator cend() const {
+        return end();
+    }
+
+private:
+    Storage storage_;
+};
+
+template <typename Key, typename Compare, size_t StagingCapacity>
+inline bool operator==(const FlatSet<Key, Compare, StagingCapacity>& lhs, const FlatSet<Key, Compare, StagingCapacity>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename Compare, size_t StagingCapacity>
+inline bool operator!=(const FlatSet<Key, Compare, StagingCapacity>& lhs, const FlatSet<Key, Compare, StagingCapacity>& rhs) {
+    return !(lhs == rhs);
+}
+
+// Ассоциативный массив с уникальными ключами, хранящий пары ключ-значение в упорядоченном SimpleVector
+// так же, как FlatSet. Обход дает пары в порядке возрастания ключей. Ключи пар изменять нельзя:
+// итераторы неконстантного массива дают пары ссылок std::pair<const Key&, Value&>, а константного — const ValueType&.
+// Ссылки на значения действительны до следующей вставки или удаления.
+// Константные методы не изменяют массив, поэтому их можно вызывать из нескольких потоков
+template <typename Key, typename Value, typename Compare = std::less<Key>, size_t StagingCapacity = 64>
+class FlatMap {
+    using PairCompare = detail::PairKeyCompare<Key, Value, Compare>;
+    using Storage = detail::SortedStorage<std::pair<Key, Value>, PairCompare, StagingCapacity>;
+
+public:
+    using ValueType = std::pair<Key, Value>;
+    using Reference = std::pair<const Key&, Value&>;
+    using Iterator = detail::FlatMapIterator<Key, Value, PairCompare>;
+    using ConstIterator = typename Storage::ConstIterator;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp) : storage_(PairCompare{ comp }) {
+    }
+
+    // Создает массив из пар init. Из пар с повторяющимися ключами остается первая
+    FlatMap(std::initializer_list<ValueType> init, const Compare& comp = Compare()) : storage_(PairCompare{ comp }) {
+        storage_.Assign(SimpleVector<ValueType>(init), true);
+    }
+
+    size_t GetSize() const noexcept {
+        return storage_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    void Clear() noexcept {
+        storage_.Clear();
+    }
+
+    // Резервирует память под capacity упорядоченных пар
+    void Reserve(size_t capacity) {
+        storage_.Reserve(capacity);
+    }
+
+    // Добавляет пару key-value, если ключа key нет в массиве. Существующее значение не изменяется.
+    // Возвращает true, если пара добавлена
+    bool Insert(Key key, Value value) {
+        if (Contains(key)) {
+            return false;
+        }
+        storage_.Stage(ValueType(std::move(key), std::move(value)));
+        return true;
+    }
+
+    // Добавляет пары [first, last) с ключами, которых нет в массиве, за одно слияние.
+    // Из пар с равными ключами остается первая
+    template <typename InputIterator, typename = detail::RequireInputIterator<InputIterator>>
+    void Insert(InputIterator first, InputIterator last) {
+        storage_.StageRange(first, last, true);
+    }
+
+    // Возвращает ссылку на значение с ключом key, добавляя значение по умолчанию, если ключа нет
+    Value& operator[](const Key& key) {
+        if (ValueType* found = storage_.Find(key)) {
+            return found->second;
+        }
+        return storage_.Stage(ValueType(key, Value())).second;
+    }
+
+    // Возвращает ссылку на значение с ключом key.
+    // Выбрасывает исключение std::out_of_range, если ключа нет
+    template <typename Other>
+    Value& At(const Other& key) {
+        if (ValueType* found = storage_.Find(key)) {
+            return found->second;
+        }
+        throw std::out_of_range("key is not found");
+    }
+
+    template <typename Other>
+    const Value& At(const Other& key) const {
+        if (const ValueType* found = storage_.Find(key)) {
+            return found->second;
+        }
+        throw std::out_of_range("key is not found");
+    }
+
+    template <typename Other>
+    bool Contains(const Other& key) const {
+        return storage_.Find(key) != nullptr;
+    }
+
+    // Возвращает итератор на пару с ключом key или end(), если ключа нет.
+    // Итератор действителен до следующего изменения массива
+    template <typename Other>
+    Iterator Find(const Other& key) {
+        ValueType* const found = storage_.Find(key);
+        return found == nullptr ? end() : Iterator(storage_.IteratorAt(found));
+    }
+
+    template <typename Other>
+    ConstIterator Find(const Other& key) const {
+        const ValueType* const found = storage_.Find(key);
+        return found == nullptr ? end() : storage_.IteratorAt(found);
+    }
+
+    // Удаляет пару с ключом key. Возвращает true, если ключ был в массиве
+    template <typename Other>
+    bool Erase(const Other& key) {
+        ValueType* const found = storage_.Find(key);
+        if (found == nullptr) {
+            return false;
+        }
+        storage_.Erase(found);
+        return true;
+    }
+
+    // Сливает накопленные вставки с упорядоченной частью
+    void Flush() {
+        storage_.Merge();
+    }
+
+    Iterator begin() {
+        return Iterator(storage_.begin());
+    }
+
+    Iterator end() {
+        return Iterator(storage_.end());
+    }
+
+    ConstIterator begin() const {
+        return storage_.begin();
+    }
+
+    ConstIterator end() const {
+        return storage_.end();
+    }
+
+    ConstIterator cbegin() const {
+        return begin();
+    }
+
+    ConstIterator cend() const {
+        return end();
+    }
+
+private:
+    Storage storage_;
+};
+
+template <typename Key, typename Value, typename Compare, size_t StagingCapacity>
+inline bool operator==(const FlatMap<Key, Value, Compare, StagingCapacity>& lhs, const FlatMap<Key, Value, Compare, StagingCapacity>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename Value, typename Compare, size_t StagingCapacity>
+inline bool operator!=(const FlatMap<Key, Value, Compare, StagingCapacity>& lhs, const FlatMap<Key, Value, Compare, StagingCapacity>& rhs) {
+    return !(lhs == rhs);
+}
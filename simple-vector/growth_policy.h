@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+// Политики роста вместимости SimpleVector.
+// Политика предоставляет статический метод NextCapacity(capacity, required, element_size),
+// который возвращает новую вместимость не меньше required для вектора вместимостью capacity
+// с элементами размером element_size байт
+
+// Увеличивает вместимость вдвое
+struct DoublingGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t) noexcept {
+        return std::max({ required, capacity * 2, static_cast<size_t>(1) });
+    }
+};
+
+// Увеличивает вместимость в полтора раза. Освобожденные при росте блоки со временем
+// могут быть переиспользованы аллокатором для следующих выделений
+struct OneAndHalfGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t) noexcept {
+        return std::max({ required, capacity + capacity / 2, static_cast<size_t>(1) });
+    }
+};
+
+// Вычисляет вместимость политикой BasePolicy и округляет размер блока вверх до класса размеров
+// типичного malloc, чтобы в векторе использовался хвост блока, который аллокатор все равно выделит
+template <typename BasePolicy = DoublingGrowth>
+struct SizeClassGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t base = BasePolicy::NextCapacity(capacity, required, element_size);
+        return std::max(base, RoundUpToSizeClass(base * element_size) / element_size);
+    }
+
+    // Округляет bytes вверх до класса размеров: до 16 байт для малых блоков,
+    // до четырех классов на каждую степень двойки для средних и до целых страниц для крупных
+    static constexpr size_t RoundUpToSizeClass(size_t bytes) noexcept {
+        constexpr size_t kQuantum = 16;
+        constexpr size_t kSmallLimit = 128;
+        constexpr size_t kPageSize = 4096;
+        constexpr size_t kLargeLimit = 4 * kPageSize;
+
+        if (bytes <= kSmallLimit) {
+            return RoundUp(std::max(bytes, kQuantum), kQuantum);
+        }
+        if (bytes >= kLargeLimit) {
+            return RoundUp(bytes, kPageSize);
+        }
+
+        size_t power = kSmallLimit;
+        while (power * 2 < bytes) {
+            power *= 2;
+        }
+        return RoundUp(bytes, power / 4);
+    }
+
+private:
+    static constexpr size_t RoundUp(size_t value, size_t step) noexcept {
+        return (value + step - 1) / step * step;
+    }
+};
+
+// Вычисляет вместимость политикой BasePolicy и дополняет размер блока до кратного PaddingBytes
+// (например, ширине векторного регистра), чтобы векторные циклы обрабатывали хвост массива
+// полными блоками без скалярного остатка
+template <size_t PaddingBytes, typename BasePolicy = DoublingGrowth>
+struct PaddedGrowth {
+    static_assert(PaddingBytes != 0, "PaddingBytes must be positive");
+
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t base = BasePolicy::NextCapacity(capacity, required, element_size);
+        const size_t padded_bytes = (base * element_size + PaddingBytes - 1) / PaddingBytes * PaddingBytes;
+        return std::max(base, padded_bytes / element_size);
+    }
+};
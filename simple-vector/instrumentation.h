@@ -0,0 +1,258 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "constexpr_support.h"
+
+// Необязательный учет выделений памяти и перемещений элементов в ArrayPtr и SimpleVector.
+// Учет включается определением макроса SIMPLE_VECTOR_INSTRUMENTATION для всей программы
+// (например, -DSIMPLE_VECTOR_INSTRUMENTATION): единицы трансляции, собранные с макросом и без него,
+// нельзя смешивать. Без макроса точки учета пусты и не добавляют кода, а счетчики остаются нулевыми
+
+#if defined(SIMPLE_VECTOR_INSTRUMENTATION)
+inline constexpr bool kVectorInstrumentation = true;
+#else
+inline constexpr bool kVectorInstrumentation = false;
+#endif
+
+// События, которые учитываются для векторов
+enum class VectorEvent {
+    // Выделен новый блок (allocate или reallocate аллокатора) под elements элементов
+    kAllocation,
+    // Элементы перенесены в новый блок при росте или ShrinkToFit
+    kRelocation,
+    // Хвост сдвинут вправо при вставке
+    kInsertShift,
+    // Хвост сдвинут влево при удалении
+    kEraseShift,
+};
+
+// Описание события для пользовательского приемника
+struct VectorEventInfo {
+    VectorEvent event;
+    // Тип элементов вектора
+    const std::type_info* type;
+    // Метка, установленная ScopedVectorTag в текущем потоке, или nullptr
+    const char* tag;
+    size_t elements;
+    size_t bytes;
+};
+
+// Накопленные счетчики событий
+struct VectorStats {
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+    uint64_t relocations = 0;
+    uint64_t relocated_elements = 0;
+    uint64_t insert_shifted_elements = 0;
+    uint64_t erase_shifted_elements = 0;
+};
+
+// Приемник событий. Вызывается в потоке, выполняющем операцию, и не должен сам изменять векторы
+using VectorSink = void (*)(const VectorEventInfo& info);
+
+namespace detail {
+
+    // Атомарные счетчики одного типа элементов или одной метки
+    struct AtomicVectorStats {
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> allocated_bytes{ 0 };
+        std::atomic<uint64_t> relocations{ 0 };
+        std::atomic<uint64_t> relocated_elements{ 0 };
+        std::atomic<uint64_t> insert_shifted_elements{ 0 };
+        std::atomic<uint64_t> erase_shifted_elements{ 0 };
+
+        void Add(VectorEvent event, size_t elements, size_t bytes) noexcept {
+            constexpr auto kOrder = std::memory_order_relaxed;
+            switch (event) {
+            case VectorEvent::kAllocation:
+                allocations.fetch_add(1, kOrder);
+                allocated_bytes.fetch_add(bytes, kOrder);
+                break;
+            case VectorEvent::kRelocation:
+                relocations.fetch_add(1, kOrder);
+                relocated_elements.fetch_add(elements, kOrder);
+                break;
+            case VectorEvent::kInsertShift:
+                insert_shifted_elements.fetch_add(elements, kOrder);
+                break;
+            case VectorEvent::kEraseShift:
+                erase_shifted_elements.fetch_add(elements, kOrder);
+                break;
+            }
+        }
+
+        VectorStats Load() const noexcept {
+            constexpr auto kOrder = std::memory_order_relaxed;
+            return { allocations.load(kOrder), allocated_bytes.load(kOrder), relocations.load(kOrder),
+                relocated_elements.load(kOrder), insert_shifted_elements.load(kOrder), erase_shifted_elements.load(kOrder) };
+        }
+
+        void Reset() noexcept {
+            for (auto* counter : { &allocations, &allocated_bytes, &relocations, &relocated_elements,
+                &insert_shifted_elements, &erase_shifted_elements }) {
+                counter->store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // Реестр счетчиков. Счетчики типов создаются при первом событии и не удаляются,
+    // поэтому указатели на них кэшируются в статических переменных TypeVectorStats
+    struct VectorStatsRegistry {
+        std::mutex mutex;
+        std::vector<std::pair<const std::type_info*, AtomicVectorStats*>> types;
+        std::map<std::string, AtomicVectorStats, std::less<>> tags;
+        std::atomic<VectorSink> sink{ nullptr };
+
+        static VectorStatsRegistry& Get() {
+            // Реестр не разрушается, чтобы события из деструкторов статических векторов оставались допустимыми
+            static VectorStatsRegistry* registry = new VectorStatsRegistry();
+            return *registry;
+        }
+    };
+
+    template <typename Type>
+    AtomicVectorStats& TypeVectorStats() {
+        static AtomicVectorStats* stats = [] {
+            auto* created = new AtomicVectorStats();
+            VectorStatsRegistry& registry = VectorStatsRegistry::Get();
+            std::lock_guard guard(registry.mutex);
+            registry.types.emplace_back(&typeid(Type), created);
+            return created;
+        }();
+        return *stats;
+    }
+
+    inline thread_local const char* current_vector_tag = nullptr;
+
+#if defined(SIMPLE_VECTOR_INSTRUMENTATION)
+    template <typename Type>
+    void RecordVectorEventAtRuntime(VectorEvent event, size_t elements) noexcept {
+        if (elements == 0 && event != VectorEvent::kAllocation) {
+            return;
+        }
+        const size_t bytes = elements * sizeof(Type);
+        const char* tag = current_vector_tag;
+        // Сбой учета (например, нехватка памяти под новую метку) не должен прерывать операцию вектора
+        try {
+            TypeVectorStats<Type>().Add(event, elements, bytes);
+            VectorStatsRegistry& registry = VectorStatsRegistry::Get();
+            if (tag) {
+                std::lock_guard guard(registry.mutex);
+                auto it = registry.tags.find(std::string_view(tag));
+                if (it == registry.tags.end()) {
+                    it = registry.tags.try_emplace(tag).first;
+                }
+                it->second.Add(event, elements, bytes);
+            }
+            if (VectorSink sink = registry.sink.load(std::memory_order_acquire)) {
+                sink(VectorEventInfo{ event, &typeid(Type), tag, elements, bytes });
+            }
+        }
+        catch (...) {
+        }
+    }
+#endif
+
+    // Учитывает событие event для elements элементов типа Type. Без SIMPLE_VECTOR_INSTRUMENTATION
+    // ничего не делает. События в константных выражениях не учитываются
+    template <typename Type>
+    SIMPLE_VECTOR_CONSTEXPR void RecordVectorEvent([[maybe_unused]] VectorEvent event, [[maybe_unused]] size_t elements) noexcept {
+#if defined(SIMPLE_VECTOR_INSTRUMENTATION)
+        if (!IsConstantEvaluated()) {
+            RecordVectorEventAtRuntime<Type>(event, elements);
+        }
+#endif
+    }
+
+}
+
+// Помечает события векторов в текущем потоке меткой tag до выхода из области видимости.
+// Метки вкладываются: по завершении восстанавливается внешняя. Строка tag должна жить, пока действует метка
+class ScopedVectorTag {
+public:
+    explicit ScopedVectorTag(const char* tag) noexcept : previous_(detail::current_vector_tag) {
+        detail::current_vector_tag = tag;
+    }
+
+    ScopedVectorTag(const ScopedVectorTag&) = delete;
+    ScopedVectorTag& operator=(const ScopedVectorTag&) = delete;
+
+    ~ScopedVectorTag() {
+        detail::current_vector_tag = previous_;
+    }
+
+private:
+    const char* previous_;
+};
+
+// Возвращает счетчики векторов с элементами типа Type
+template <typename Type>
+VectorStats GetVectorStats() {
+    return detail::TypeVectorStats<Type>().Load();
+}
+
+// Возвращает счетчики событий, произошедших под меткой tag
+inline VectorStats GetVectorTagStats(const std::string& tag) {
+    detail::VectorStatsRegistry& registry = detail::VectorStatsRegistry::Get();
+    std::lock_guard guard(registry.mutex);
+    const auto it = registry.tags.find(tag);
+    return it == registry.tags.end() ? VectorStats{} : it->second.Load();
+}
+
+// Вызывает visitor(name, stats) для каждого типа элементов, по которому были события.
+// name — имя типа из std::type_info::name()
+template <typename Visitor>
+void VisitVectorTypeStats(Visitor visitor) {
+    detail::VectorStatsRegistry& registry = detail::VectorStatsRegistry::Get();
+    std::vector<std::pair<const char*, VectorStats>> snapshot;
+    {
+        std::lock_guard guard(registry.mutex);
+        for (const auto& [type, stats] : registry.types) {
+            snapshot.emplace_back(type->name(), stats->Load());
+        }
+    }
+    for (const auto& [name, stats] : snapshot) {
+        visitor(name, stats);
+    }
+}
+
+// Вызывает visitor(tag, stats) для каждой метки, под которой были события
+template <typename Visitor>
+void VisitVectorTagStats(Visitor visitor) {
+    detail::VectorStatsRegistry& registry = detail::VectorStatsRegistry::Get();
+    std::vector<std::pair<std::string, VectorStats>> snapshot;
+    {
+        std::lock_guard guard(registry.mutex);
+        for (const auto& [tag, stats] : registry.tags) {
+            snapshot.emplace_back(tag, stats.Load());
+        }
+    }
+    for (const auto& [tag, stats] : snapshot) {
+        visitor(tag, stats);
+    }
+}
+
+// Обнуляет все счетчики
+inline void ResetVectorStats() {
+    detail::VectorStatsRegistry& registry = detail::VectorStatsRegistry::Get();
+    std::lock_guard guard(registry.mutex);
+    for (const auto& [type, stats] : registry.types) {
+        stats->Reset();
+    }
+    registry.tags.clear();
+}
+
+// Устанавливает приемник, получающий каждое событие, или снимает его при nullptr
+inline void SetVectorSink(VectorSink sink) noexcept {
+    detail::VectorStatsRegistry::Get().sink.store(sink, std::memory_order_release);
+}
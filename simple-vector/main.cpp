@@ -9,19 +9,48 @@ int main() {
     tests::At();
     tests::Clear();
     tests::Resize();
+    tests::TriviallyRelocatable();
+    tests::Reserve();
+    tests::NonDefaultConstructible();
     tests::Iterate();
     tests::PushBack();
     tests::PopBack();
     tests::CopyConstructor();
     tests::Compare();
+    tests::CompareKernels();
     tests::Swap();
     tests::CopyAssignment();
     tests::Insert();
+    tests::Emplace();
+    tests::RangeInsert();
     tests::Erase();
+    tests::EraseRange();
+    tests::ShrinkToFit();
+    tests::GrowthPolicy();
+    tests::MmapStorage();
+    tests::ParallelConstruction();
+    tests::ThrowingMoveInsert();
+    tests::ConcurrentPushBack();
+    tests::SegmentedVectorStableAddresses();
+    tests::CopyOnWrite();
+    tests::MappedFile();
+    tests::Serialization();
+    tests::View();
+    tests::StructureOfArrays();
+    tests::AlignedStorage();
+    tests::Instrumentation();
+    tests::OverwriteGrowth();
+    tests::SortedContainers();
+    tests::BitVectorBasics();
+    tests::ConstexprVector();
     tests::MoveConstructor();
     tests::MoveAssignment();
     tests::NoncopiableMoveConstructor();
     tests::NoncopiablePushBack();
     tests::NoncopiableInsert();
     tests::NoncopiableErase();
+    tests::PmrResource();
+    tests::AllocatorPropagation();
+    tests::SmallVectorInline();
+    tests::SmallVectorSwapAndMove();
 }
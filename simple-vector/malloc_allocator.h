@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Аллокатор по умолчанию для ArrayPtr и SimpleVector, удовлетворяющий требованиям стандартной модели аллокаторов.
+// Память под типы с обычным выравниванием выделяется через std::malloc, поэтому помимо
+// стандартных allocate/deallocate аллокатор предоставляет reallocate, расширяющий блок через std::realloc.
+// Для сверхвыровненных типов используется выравнивающий operator new
+template <typename Type>
+class MallocAllocator {
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    MallocAllocator() noexcept = default;
+
+    template <typename Other>
+    constexpr MallocAllocator(const MallocAllocator<Other>&) noexcept {
+    }
+
+    // Выделяет неинициализированную память под n элементов
+    [[nodiscard]] Type* allocate(size_t n) {
+        const size_t bytes = CheckedBytes(n);
+        if constexpr (kUseMalloc) {
+            void* p = std::malloc(bytes);
+            if (!p) {
+                throw std::bad_alloc();
+            }
+            return static_cast<Type*>(p);
+        }
+        else {
+            return static_cast<Type*>(::operator new(bytes, std::align_val_t{alignof(Type)}));
+        }
+    }
+
+    // Освобождает память, выделенную через allocate или reallocate
+    void deallocate(Type* p, size_t) noexcept {
+        if constexpr (kUseMalloc) {
+            std::free(static_cast<void*>(p));
+        }
+        else {
+            ::operator delete(static_cast<void*>(p), std::align_val_t{alignof(Type)});
+        }
+    }
+
+    // Изменяет размер блока p с old_n до new_n элементов, побайтово сохраняя его начало.
+    // Допустимо только для тривиально перемещаемых типов. При ошибке выбрасывает std::bad_alloc,
+    // и блок p остается действительным
+    [[nodiscard]] Type* reallocate(Type* p, size_t old_n, size_t new_n) {
+        if constexpr (kUseMalloc) {
+            void* new_p = std::realloc(static_cast<void*>(p), CheckedBytes(new_n));
+            if (!new_p) {
+                throw std::bad_alloc();
+            }
+            return static_cast<Type*>(new_p);
+        }
+        else {
+            Type* new_p = allocate(new_n);
+            if (p) {
+                std::memcpy(static_cast<void*>(new_p), static_cast<const void*>(p), std::min(old_n, new_n) * sizeof(Type));
+                deallocate(p, old_n);
+            }
+            return new_p;
+        }
+    }
+
+private:
+    static constexpr bool kUseMalloc = alignof(Type) <= alignof(std::max_align_t);
+
+    static size_t CheckedBytes(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(Type);
+    }
+};
+
+template <typename Type, typename Other>
+constexpr bool operator==(const MallocAllocator<Type>&, const MallocAllocator<Other>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Other>
+constexpr bool operator!=(const MallocAllocator<Type>&, const MallocAllocator<Other>&) noexcept {
+    return false;
+}
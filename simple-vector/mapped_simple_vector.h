@@ -0,0 +1,445 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "compare_kernels.h"
+#include "simple_vector.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SIMPLE_VECTOR_HAS_MAPPED_FILES 1
+#else
+#define SIMPLE_VECTOR_HAS_MAPPED_FILES 0
+#endif
+
+#if SIMPLE_VECTOR_HAS_MAPPED_FILES
+
+// Заголовок файла вектора: за ним с выравниванием на kMappedDataOffset байт следуют capacity элементов,
+// из которых значимы первые size. Поля записываются в порядке байтов машины, создавшей файл
+struct MappedFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t element_size;
+    uint64_t element_alignment;
+    uint64_t size;
+    uint64_t capacity;
+};
+
+inline constexpr char kMappedMagic[8] = { 'S', 'V', 'E', 'C', 'T', 'O', 'R', '\0' };
+inline constexpr uint32_t kMappedVersion = 1;
+inline constexpr uint32_t kMappedByteOrder = 0x01020304;
+inline constexpr size_t kMappedDataOffset = 64;
+
+static_assert(sizeof(MappedFileHeader) <= kMappedDataOffset);
+
+namespace detail {
+
+    [[noreturn]] inline void ThrowSystemError(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Закрывает дескриптор файла при выходе из области видимости
+    class FileDescriptor {
+    public:
+        explicit FileDescriptor(int fd) noexcept : fd_(fd) {
+        }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+        ~FileDescriptor() {
+            if (fd_ >= 0) {
+                close(fd_);
+            }
+        }
+
+        int Get() const noexcept {
+            return fd_;
+        }
+
+        int Release() noexcept {
+            return std::exchange(fd_, -1);
+        }
+
+    private:
+        int fd_;
+    };
+
+    // Записывает bytes байт из data в файл fd, повторяя запись после частичных записей и прерываний
+    inline void WriteAll(int fd, const void* data, size_t bytes, const std::string& path) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        while (bytes != 0) {
+            const ssize_t written = write(fd, p, bytes);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ThrowSystemError("cannot write " + path);
+            }
+            p += written;
+            bytes -= static_cast<size_t>(written);
+        }
+    }
+
+    template <typename Type>
+    MappedFileHeader MakeMappedHeader(size_t size, size_t capacity) noexcept {
+        MappedFileHeader header{};
+        std::memcpy(header.magic, kMappedMagic, sizeof(header.magic));
+        header.version = kMappedVersion;
+        header.byte_order = kMappedByteOrder;
+        header.element_size = sizeof(Type);
+        header.element_alignment = alignof(Type);
+        header.size = size;
+        header.capacity = capacity;
+        return header;
+    }
+
+    // Проверяет, что заголовок описывает вектор элементов Type и помещается в файл размером file_size байт.
+    // Выбрасывает std::runtime_error с описанием несовпадения
+    template <typename Type>
+    void ValidateMappedHeader(const MappedFileHeader& header, uint64_t file_size, const std::string& path) {
+        if (std::memcmp(header.magic, kMappedMagic, sizeof(header.magic)) != 0) {
+            throw std::runtime_error(path + " is not a SimpleVector file");
+        }
+        if (header.byte_order != kMappedByteOrder) {
+            throw std::runtime_error(path + " was written with a different byte order");
+        }
+        if (header.version != kMappedVersion) {
+            throw std::runtime_error(path + " has unsupported version " + std::to_string(header.version));
+        }
+        if (header.element_size != sizeof(Type) || header.element_alignment != alignof(Type)) {
+            throw std::runtime_error(path + " stores elements of size " + std::to_string(header.element_size)
+                + ", expected " + std::to_string(sizeof(Type)));
+        }
+        if (header.size > header.capacity
+            || header.capacity > (file_size - kMappedDataOffset) / sizeof(Type)) {
+            throw std::runtime_error(path + " is truncated");
+        }
+    }
+
+}
+
+// Сохраняет элементы вектора в файл path в формате, который отображает MappedSimpleVector:
+// заголовок MappedFileHeader и следом элементы побайтово
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void SaveToFile(const SimpleVector<Type, Allocator, GrowthPolicy>& vector, const std::string& path) {
+    static_assert(std::is_trivially_copyable_v<Type>, "Type must be trivially copyable");
+
+    detail::FileDescriptor file(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644));
+    if (file.Get() < 0) {
+        detail::ThrowSystemError("cannot create " + path);
+    }
+    unsigned char header[kMappedDataOffset] = {};
+    const MappedFileHeader fields = detail::MakeMappedHeader<Type>(vector.GetSize(), vector.GetSize());
+    std::memcpy(header, &fields, sizeof(fields));
+    detail::WriteAll(file.Get(), header, sizeof(header), path);
+    detail::WriteAll(file.Get(), vector.begin(), vector.GetSize() * sizeof(Type), path);
+    if (close(file.Release()) != 0) {
+        detail::ThrowSystemError("cannot write " + path);
+    }
+}
+
+// Режим отображения MappedSimpleVector
+enum class MappedMode {
+    kReadOnly,
+    kReadWrite,
+};
+
+// Вектор тривиально копируемых элементов, отображенный из файла без копирования.
+// В режиме kReadOnly предоставляет только константный интерфейс SimpleVector, в том числе у неконстантного
+// объекта: открытие стоит порядка вызова mmap, а страницы подгружаются при первом обращении.
+// В режиме kReadWrite файл создается при отсутствии, изменения пишутся прямо в отображение,
+// а Reserve и рост при PushBack увеличивают файл
+template <typename Type, MappedMode Mode = MappedMode::kReadOnly>
+class MappedSimpleVector {
+    static_assert(std::is_trivially_copyable_v<Type>, "Type must be trivially copyable");
+    static_assert(alignof(Type) <= kMappedDataOffset, "Type is over-aligned");
+
+    static constexpr bool kWritable = Mode == MappedMode::kReadWrite;
+
+public:
+    // В режиме kReadOnly отображение защищено от записи, поэтому элементы доступны только для чтения
+    using Iterator = std::conditional_t<kWritable, Type*, const Type*>;
+    using ConstIterator = const Type*;
+    using Reference = std::conditional_t<kWritable, Type&, const Type&>;
+
+    // Отображает файл path. Выбрасывает std::system_error при ошибке ввода-вывода
+    // и std::runtime_error, если файл не описывает вектор элементов Type
+    explicit MappedSimpleVector(const std::string& path) : path_(path) {
+        const bool writable = kWritable;
+        detail::FileDescriptor file(open(path.c_str(), writable ? O_RDWR | O_CREAT : O_RDONLY, 0644));
+        if (file.Get() < 0) {
+            detail::ThrowSystemError("cannot open " + path);
+        }
+
+        struct stat info;
+        if (fstat(file.Get(), &info) != 0) {
+            detail::ThrowSystemError("cannot stat " + path);
+        }
+        size_t file_size = static_cast<size_t>(info.st_size);
+        if (writable && file_size == 0) {
+            unsigned char header[kMappedDataOffset] = {};
+            const MappedFileHeader fields = detail::MakeMappedHeader<Type>(0, 0);
+            std::memcpy(header, &fields, sizeof(fields));
+            detail::WriteAll(file.Get(), header, sizeof(header), path);
+            file_size = kMappedDataOffset;
+        }
+        if (file_size < kMappedDataOffset) {
+            throw std::runtime_error(path + " is not a SimpleVector file");
+        }
+
+        const int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* mapping = mmap(nullptr, file_size, protection, MAP_SHARED, file.Get(), 0);
+        if (mapping == MAP_FAILED) {
+            detail::ThrowSystemError("cannot map " + path);
+        }
+        mapping_ = static_cast<unsigned char*>(mapping);
+        mapping_size_ = file_size;
+        try {
+            detail::ValidateMappedHeader<Type>(Header_(), file_size, path);
+        }
+        catch (...) {
+            munmap(mapping_, mapping_size_);
+            throw;
+        }
+        if (writable) {
+            fd_ = file.Release();
+        }
+    }
+
+    MappedSimpleVector(const MappedSimpleVector&) = delete;
+    MappedSimpleVector& operator=(const MappedSimpleVector&) = delete;
+
+    MappedSimpleVector(MappedSimpleVector&& other) noexcept
+        : path_(std::move(other.path_))
+        , fd_(std::exchange(other.fd_, -1))
+        , mapping_(std::exchange(other.mapping_, nullptr))
+        , mapping_size_(std::exchange(other.mapping_size_, 0)) {
+    }
+
+    MappedSimpleVector& operator=(MappedSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            MappedSimpleVector moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    ~MappedSimpleVector() {
+        if (mapping_) {
+            munmap(mapping_, mapping_size_);
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(MappedSimpleVector& other) noexcept {
+        std::swap(path_, other.path_);
+        std::swap(fd_, other.fd_);
+        std::swap(mapping_, other.mapping_);
+        std::swap(mapping_size_, other.mapping_size_);
+    }
+
+    // Сообщает, допускает ли отображение изменения
+    static constexpr bool IsWritable() noexcept {
+        return kWritable;
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return mapping_ ? static_cast<size_t>(Header_().size) : 0;
+    }
+
+    // Возвращает вместимость массива
+    size_t GetCapacity() const noexcept {
+        return mapping_ ? static_cast<size_t>(Header_().capacity) : 0;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return begin()[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index, константную в режиме kReadOnly
+    Reference operator[](size_t index) noexcept {
+        assert(index < GetSize());
+        return begin()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("index is out of range");
+        }
+        return begin()[index];
+    }
+
+    // Добавляет элемент в конец вектора, при нехватке места вдвое увеличивая файл.
+    // Изменяющие методы доступны только в режиме kReadWrite
+    void PushBack(const Type& item) {
+        RequireWritable_();
+        const size_t size = GetSize();
+        if (size == GetCapacity()) {
+            // item может ссылаться на элемент отображения, которое переместится при росте
+            const Type copy = item;
+            Reserve(std::max<size_t>(1, size * 2));
+            Data_()[size] = copy;
+        }
+        else {
+            Data_()[size] = item;
+        }
+        Header_().size = size + 1;
+    }
+
+    // Удаляет последний элемент вектора
+    void PopBack() {
+        RequireWritable_();
+        assert(!IsEmpty());
+        --Header_().size;
+    }
+
+    // Изменяет размер массива. Новые элементы инициализируются значением по умолчанию
+    void Resize(size_t new_size) {
+        RequireWritable_();
+        if (new_size > GetCapacity()) {
+            Reserve(std::max(new_size, GetCapacity() * 2));
+        }
+        const size_t size = GetSize();
+        if (new_size > size) {
+            std::uninitialized_value_construct(Data_() + size, Data_() + new_size);
+        }
+        Header_().size = new_size;
+    }
+
+    // Обнуляет размер массива, не изменяя его вместимость
+    void Clear() {
+        RequireWritable_();
+        Header_().size = 0;
+    }
+
+    // Увеличивает файл и отображение до вместимости new_capacity элементов
+    void Reserve(size_t new_capacity) {
+        RequireWritable_();
+        if (new_capacity <= GetCapacity()) {
+            return;
+        }
+        const size_t new_size = kMappedDataOffset + new_capacity * sizeof(Type);
+        if (ftruncate(fd_, static_cast<off_t>(new_size)) != 0) {
+            detail::ThrowSystemError("cannot grow " + path_);
+        }
+#if defined(__linux__)
+        void* mapping = mremap(mapping_, mapping_size_, new_size, MREMAP_MAYMOVE);
+        if (mapping == MAP_FAILED) {
+            detail::ThrowSystemError("cannot map " + path_);
+        }
+#else
+        void* mapping = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            detail::ThrowSystemError("cannot map " + path_);
+        }
+        munmap(mapping_, mapping_size_);
+#endif
+        mapping_ = static_cast<unsigned char*>(mapping);
+        mapping_size_ = new_size;
+        Header_().capacity = new_capacity;
+    }
+
+    // Сбрасывает изменения отображения на диск
+    void Flush() {
+        if constexpr (kWritable) {
+            if (msync(mapping_, mapping_size_, MS_SYNC) != 0) {
+                detail::ThrowSystemError("cannot flush " + path_);
+            }
+        }
+    }
+
+    // Возвращает итератор на начало массива, константный в режиме kReadOnly
+    Iterator begin() noexcept {
+        if constexpr (kWritable) {
+            return mapping_ ? Data_() : nullptr;
+        }
+        else {
+            return std::as_const(*this).begin();
+        }
+    }
+
+    Iterator end() noexcept {
+        return begin() + GetSize();
+    }
+
+    ConstIterator begin() const noexcept {
+        return mapping_ ? std::launder(reinterpret_cast<const Type*>(mapping_ + kMappedDataOffset)) : nullptr;
+    }
+
+    ConstIterator end() const noexcept {
+        return begin() + GetSize();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    std::string path_;
+    // Дескриптор файла открыт только в режиме kReadWrite, где он нужен для роста файла
+    int fd_ = -1;
+    unsigned char* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+
+    MappedFileHeader& Header_() noexcept {
+        return *std::launder(reinterpret_cast<MappedFileHeader*>(mapping_));
+    }
+
+    const MappedFileHeader& Header_() const noexcept {
+        return *std::launder(reinterpret_cast<const MappedFileHeader*>(mapping_));
+    }
+
+    Type* Data_() noexcept {
+        return std::launder(reinterpret_cast<Type*>(mapping_ + kMappedDataOffset));
+    }
+
+    static void RequireWritable_() noexcept {
+        static_assert(kWritable, "the vector is mapped read-only");
+    }
+};
+
+template <typename Type, MappedMode LhsMode, MappedMode RhsMode>
+inline bool operator==(const MappedSimpleVector<Type, LhsMode>& lhs, const MappedSimpleVector<Type, RhsMode>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && detail::RangesEqual(lhs.begin(), rhs.begin(), lhs.GetSize());
+}
+
+template <typename Type, MappedMode LhsMode, MappedMode RhsMode>
+inline bool operator!=(const MappedSimpleVector<Type, LhsMode>& lhs, const MappedSimpleVector<Type, RhsMode>& rhs) {
+    return !(lhs == rhs);
+}
+
+#endif
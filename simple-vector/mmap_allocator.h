@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "malloc_allocator.h"
+#include "relocation.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Порог по умолчанию, начиная с которого MmapAllocator отображает память через mmap
+inline constexpr size_t kDefaultMmapThreshold = 1 << 20;
+
+// Аллокатор для больших векторов тривиально перемещаемых элементов.
+// Блоки меньше ThresholdBytes выделяются как в MallocAllocator, более крупные отображаются анонимным mmap.
+// reallocate расширяет отображенный блок через mremap: страницы переназначаются без копирования данных,
+// поэтому рост вектора в несколько гигабайт не требует памяти под старую и новую копии одновременно.
+// Если HugePages равен true, крупные блоки помечаются через madvise(MADV_HUGEPAGE) как кандидаты
+// на прозрачные огромные страницы; это только подсказка ядру, и ее отклонение не считается ошибкой.
+// Вне Linux все блоки выделяются как в MallocAllocator. Пример: SimpleVector<double, MmapAllocator<double>>
+template <typename Type, size_t ThresholdBytes = kDefaultMmapThreshold, bool HugePages = false>
+class MmapAllocator {
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    template <typename Other>
+    struct rebind {
+        using other = MmapAllocator<Other, ThresholdBytes, HugePages>;
+    };
+
+    MmapAllocator() noexcept = default;
+
+    template <typename Other>
+    MmapAllocator(const MmapAllocator<Other, ThresholdBytes, HugePages>&) noexcept {
+    }
+
+    // Выделяет неинициализированную память под n элементов
+    [[nodiscard]] Type* allocate(size_t n) {
+        if (!IsMapped(n)) {
+            return Small().allocate(n);
+        }
+        return static_cast<Type*>(Map(MappedBytes(n)));
+    }
+
+    // Освобождает память, выделенную через allocate или reallocate под n элементов
+    void deallocate(Type* p, size_t n) noexcept {
+        if (!IsMapped(n)) {
+            Small().deallocate(p, n);
+        }
+        else {
+            Unmap(p, MappedBytes(n));
+        }
+    }
+
+    // Изменяет размер блока p с old_n до new_n элементов, побайтово сохраняя его начало.
+    // Отображенный блок растет и уменьшается через mremap, блок ниже порога — через std::realloc.
+    // При ошибке выбрасывает std::bad_alloc, и блок p остается действительным
+    [[nodiscard]] Type* reallocate(Type* p, size_t old_n, size_t new_n) {
+        static_assert(IsTriviallyRelocatableV<Type>, "Type must be trivially relocatable");
+
+        if (!p) {
+            return allocate(new_n);
+        }
+
+        const bool old_mapped = IsMapped(old_n);
+        const bool new_mapped = IsMapped(new_n);
+        if (!old_mapped && !new_mapped) {
+            return Small().reallocate(p, old_n, new_n);
+        }
+#if defined(__linux__)
+        if (old_mapped && new_mapped) {
+            const size_t old_bytes = MappedBytes(old_n);
+            const size_t new_bytes = MappedBytes(new_n);
+            if (old_bytes == new_bytes) {
+                return p;
+            }
+            void* new_p = mremap(static_cast<void*>(p), old_bytes, new_bytes, MREMAP_MAYMOVE);
+            if (new_p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            AdviseHugePages(new_p, new_bytes);
+            return static_cast<Type*>(new_p);
+        }
+#endif
+
+        // Блок пересекает порог: данные копируются между malloc и отображенной памятью
+        Type* new_p = allocate(new_n);
+        std::memcpy(static_cast<void*>(new_p), static_cast<const void*>(p), std::min(old_n, new_n) * sizeof(Type));
+        deallocate(p, old_n);
+        return new_p;
+    }
+
+private:
+    static MallocAllocator<Type> Small() noexcept {
+        return {};
+    }
+
+    // Сообщает, отображается ли блок из n элементов через mmap
+    static bool IsMapped([[maybe_unused]] size_t n) noexcept {
+#if defined(__linux__)
+        return n != 0 && n >= (ThresholdBytes + sizeof(Type) - 1) / sizeof(Type);
+#else
+        return false;
+#endif
+    }
+
+#if defined(__linux__)
+    static size_t PageSize() noexcept {
+        static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return page_size;
+    }
+
+    // Размер отображения под n элементов, округленный вверх до целых страниц
+    static size_t MappedBytes(size_t n) {
+        if (n > (std::numeric_limits<size_t>::max() - PageSize()) / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return (n * sizeof(Type) + PageSize() - 1) / PageSize() * PageSize();
+    }
+
+    static void* Map(size_t bytes) {
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        AdviseHugePages(p, bytes);
+        return p;
+    }
+
+    static void Unmap(Type* p, size_t bytes) noexcept {
+        munmap(static_cast<void*>(p), bytes);
+    }
+
+    static void AdviseHugePages([[maybe_unused]] void* p, [[maybe_unused]] size_t bytes) noexcept {
+#if defined(MADV_HUGEPAGE)
+        if constexpr (HugePages) {
+            madvise(p, bytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+#else
+    static size_t MappedBytes(size_t n) noexcept {
+        return n * sizeof(Type);
+    }
+
+    static void* Map(size_t) {
+        throw std::bad_alloc();
+    }
+
+    static void Unmap(Type*, size_t) noexcept {
+    }
+#endif
+};
+
+template <typename Type, typename Other, size_t ThresholdBytes, bool HugePages>
+inline bool operator==(const MmapAllocator<Type, ThresholdBytes, HugePages>&, const MmapAllocator<Other, ThresholdBytes, HugePages>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Other, size_t ThresholdBytes, bool HugePages>
+inline bool operator!=(const MmapAllocator<Type, ThresholdBytes, HugePages>&, const MmapAllocator<Other, ThresholdBytes, HugePages>&) noexcept {
+    return false;
+}
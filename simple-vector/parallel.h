@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Параметры параллельного выполнения массовых операций SimpleVector (создание, заполнение, копирование, Resize).
+// Операция над блоком меньше threshold_bytes или при threads <= 1 выполняется в вызывающем потоке.
+// Иначе диапазон делится на threads частей по границам страниц памяти, и каждый поток первым обращается
+// к страницам своей части, поэтому на NUMA-машинах страницы размещаются у узла потока, который их заполнил
+struct ParallelExecution {
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t threshold_bytes = 16 << 20;
+};
+
+namespace detail {
+
+    // Граница, по которой выравниваются части диапазона, чтобы потоки не делили страницы
+    inline constexpr size_t kParallelPageBytes = 4096;
+
+    // Вызывает body(first, last) для частей диапазона [0, count) элементов размером element_size байт,
+    // расположенных по адресу data. Границы частей отсчитываются от адреса data, а не от первого элемента,
+    // поэтому совпадают с границами страниц и соседние части делят страницу, только если на границе
+    // лежит элемент, не делящий размер страницы. Первая часть обрабатывается в вызывающем потоке.
+    // Если поток не удалось создать, его часть также выполняется в вызывающем потоке.
+    // body не должен выбрасывать исключений
+    template <typename Body>
+    void ParallelFor(const void* data, size_t count, size_t element_size, const ParallelExecution& execution, Body body) noexcept {
+        if (count == 0 || execution.threads <= 1 || count * element_size < execution.threshold_bytes) {
+            body(size_t{ 0 }, count);
+            return;
+        }
+
+        // Смещения ниже отсчитываются от начала страницы, на которой лежит первый элемент
+        const size_t offset = reinterpret_cast<uintptr_t>(data) % kParallelPageBytes;
+        const size_t pages = (offset + count * element_size + kParallelPageBytes - 1) / kParallelPageBytes;
+        const size_t parts = std::min(execution.threads, pages);
+        const size_t part_bytes = (pages + parts - 1) / parts * kParallelPageBytes;
+        // Индекс первого элемента, который начинается не раньше границы страницы boundary
+        const auto first_at = [offset, count, element_size](size_t boundary) {
+            return std::min(count, (boundary - offset + element_size - 1) / element_size);
+        };
+
+        std::vector<std::thread> workers;
+        try {
+            workers.reserve(parts - 1);
+        }
+        catch (...) {
+        }
+        const size_t caller_last = first_at(part_bytes);
+        for (size_t boundary = part_bytes, first = caller_last; first < count;) {
+            boundary += part_bytes;
+            const size_t last = first_at(boundary);
+            if (first < last) {
+                try {
+                    workers.emplace_back(body, first, last);
+                }
+                catch (...) {
+                    body(first, last);
+                }
+            }
+            first = last;
+        }
+        body(size_t{ 0 }, caller_last);
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+}
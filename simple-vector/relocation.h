@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "constexpr_support.h"
+
+// Признак тривиальной перемещаемости: объект типа Type можно перенести в другую область памяти
+// побайтовым копированием, не вызывая конструктор перемещения у нового объекта и деструктор у старого.
+// По умолчанию признак выводится для тривиально копируемых типов.
+// Пользовательский тип может объявить себя тривиально перемещаемым специализацией шаблона:
+//
+//     template <>
+//     struct IsTriviallyRelocatable<MyType> : std::true_type {};
+template <typename Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {
+};
+
+template <typename Type>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<Type>::value;
+
+// Переносит элементы [first, last) в неинициализированную память dest.
+// После вызова память исходного диапазона считается неинициализированной.
+// Элементы с бросающим конструктором перемещения копируются, если это возможно, а исходные разрушаются
+// только после переноса всех, поэтому при исключении исходный диапазон не изменяется. Диапазоны не должны перекрываться
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedRelocate(Type* first, Type* last, Type* dest) {
+    if (detail::IsConstantEvaluated()) {
+        // Побайтовое копирование недоступно в константных выражениях
+        for (; first != last; ++first, ++dest) {
+            detail::ConstructAt(dest, std::move(*first));
+            std::destroy_at(first);
+        }
+    }
+    else if constexpr (IsTriviallyRelocatableV<Type>) {
+        if (first != last) {
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(Type));
+        }
+    }
+    else {
+        detail::UninitializedMoveIfNoexcept(first, last, dest);
+        std::destroy(first, last);
+    }
+}
+
+// Переносит элементы [first, last) в неинициализированную память dest, оставляя перед элементами,
+// начиная с pos, промежуток из gap неинициализированных ячеек. Гарантии исключений как у UninitializedRelocate:
+// если перенос второй части выбросит исключение, уже перенесенная первая часть разрушается в dest
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedRelocateAround(Type* first, Type* pos, Type* last, Type* dest, size_t gap) {
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        if (!detail::IsConstantEvaluated()) {
+            UninitializedRelocate(first, pos, dest);
+            UninitializedRelocate(pos, last, dest + (pos - first) + gap);
+            return;
+        }
+    }
+    Type* const head_end = detail::UninitializedMoveIfNoexcept(first, pos, dest);
+    try {
+        detail::UninitializedMoveIfNoexcept(pos, last, head_end + gap);
+    }
+    catch (...) {
+        std::destroy(dest, head_end);
+        throw;
+    }
+    std::destroy(first, last);
+}
+
+// Переносит элементы [first, last) в dest. Диапазоны могут перекрываться.
+// Тривиально перемещаемые элементы переносятся через memmove (кроме константных выражений), остальные по одному
+// (перемещающим конструктором с разрушением исходного элемента) в порядке, безопасном при перекрытии.
+// После вызова ячейки исходного диапазона, не попавшие в [dest, dest + (last - first)), не инициализированы
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void RelocateOverlapping(Type* first, Type* last, Type* dest)
+    noexcept(IsTriviallyRelocatableV<Type> || std::is_nothrow_move_constructible_v<Type>) {
+    if constexpr (IsTriviallyRelocatableV<Type>) {
+        if (!detail::IsConstantEvaluated()) {
+            if (first != last) {
+                std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(Type));
+            }
+            return;
+        }
+    }
+    if (dest < first) {
+        for (; first != last; ++first, ++dest) {
+            detail::ConstructAt(dest, std::move(*first));
+            std::destroy_at(first);
+        }
+    }
+    else if (dest > first) {
+        for (Type* d_last = dest + (last - first); first != last;) {
+            detail::ConstructAt(--d_last, std::move(*--last));
+            std::destroy_at(last);
+        }
+    }
+}
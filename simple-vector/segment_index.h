@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace detail {
+
+    // Возвращает номер старшего единичного бита value, value != 0
+    constexpr size_t FloorLog2(size_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(value);
+#else
+        size_t result = 0;
+        while (value >>= 1) {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    // Разбиение индексов на сегменты геометрически растущего размера: сегмент k вмещает
+    // FirstSegmentSize * 2^k элементов и начинается с индекса FirstSegmentSize * (2^k - 1).
+    // Сегмент и смещение в нем вычисляются за O(1) по старшему биту индекса, а уже выделенные
+    // сегменты при росте не перемещаются
+    template <size_t FirstSegmentSize>
+    struct SegmentIndex {
+        static_assert(FirstSegmentSize != 0 && (FirstSegmentSize & (FirstSegmentSize - 1)) == 0,
+            "FirstSegmentSize must be a power of two");
+
+        // Положение элемента: номер сегмента и смещение внутри него
+        struct Position {
+            size_t segment;
+            size_t offset;
+        };
+
+        static constexpr size_t kFirstSegmentBits = FloorLog2(FirstSegmentSize);
+
+        // Наибольшее число сегментов, индексы которых помещаются в size_t
+        static constexpr size_t kMaxSegments = std::numeric_limits<size_t>::digits - kFirstSegmentBits;
+
+        // Возвращает положение элемента с индексом index
+        static constexpr Position Locate(size_t index) noexcept {
+            const size_t shifted = index + FirstSegmentSize;
+            const size_t segment = FloorLog2(shifted) - kFirstSegmentBits;
+            return { segment, shifted - (FirstSegmentSize << segment) };
+        }
+
+        // Возвращает число элементов в сегменте segment
+        static constexpr size_t SegmentSize(size_t segment) noexcept {
+            return FirstSegmentSize << segment;
+        }
+
+        // Возвращает индекс первого элемента сегмента segment
+        static constexpr size_t SegmentBegin(size_t segment) noexcept {
+            return (FirstSegmentSize << segment) - FirstSegmentSize;
+        }
+
+        // Возвращает число сегментов, необходимых для хранения size элементов
+        static constexpr size_t SegmentCount(size_t size) noexcept {
+            return size == 0 ? 0 : Locate(size - 1).segment + 1;
+        }
+    };
+
+}
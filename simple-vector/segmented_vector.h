@@ -0,0 +1,428 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "malloc_allocator.h"
+#include "segment_index.h"
+
+// Вектор, хранящий элементы в сегментах геометрически растущего размера.
+// При росте выделяется новый сегмент, а существующие элементы не перемещаются, поэтому добавление
+// в конец не вызывает копирования всех элементов, а указатели и ссылки на элементы остаются действительными
+// до их удаления. Доступ по индексу выполняется за O(1).
+// Вместимость, выделенная под сегменты, сохраняется после PopBack и Clear
+template <typename Type, typename Allocator = MallocAllocator<Type>, size_t FirstSegmentSize = 64>
+class SegmentedVector {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+    using Index = detail::SegmentIndex<FirstSegmentSize>;
+
+    // Итератор произвольного доступа, хранящий вектор и индекс элемента
+    template <typename Owner, typename Value>
+    class BasicIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        BasicIterator() = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept : owner_(owner), index_(index) {
+        }
+
+        // Неконстантный итератор преобразуется в константный
+        template <typename OtherOwner, typename OtherValue,
+            typename = std::enable_if_t<std::is_convertible_v<OtherValue*, Value*>>>
+        BasicIterator(const BasicIterator<OtherOwner, OtherValue>& other) noexcept
+            : owner_(other.owner_), index_(other.index_) {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return &(*owner_)[index_];
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return (*owner_)[index_ + offset];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy(*this);
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy(*this);
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        template <typename, typename>
+        friend class BasicIterator;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<SegmentedVector, Type>;
+    using ConstIterator = BasicIterator<const SegmentedVector, const Type>;
+
+    SegmentedVector() noexcept = default;
+
+    explicit SegmentedVector(const Allocator& alloc) noexcept : alloc_(alloc) {
+    }
+
+    // Создает вектор из std::initializer_list
+    SegmentedVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator()) : SegmentedVector(alloc) {
+        Reserve(init.size());
+        for (const Type& item : init) {
+            PushBack(item);
+        }
+    }
+
+    // Копия получает аллокатор, возвращаемый select_on_container_copy_construction
+    SegmentedVector(const SegmentedVector& other)
+        : SegmentedVector(other, AllocatorTraits::select_on_container_copy_construction(other.alloc_)) {
+    }
+
+    SegmentedVector(const SegmentedVector& other, const Allocator& alloc) : SegmentedVector(alloc) {
+        Reserve(other.GetSize());
+        for (const Type& item : other) {
+            PushBack(item);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : alloc_(std::move(other.alloc_))
+        , segments_(std::exchange(other.segments_, {}))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    // Если аллокаторы не равны, элементы other перемещаются по одному в сегменты, выделенные аллокатором alloc,
+    // а other становится пустым
+    SegmentedVector(SegmentedVector&& other, const Allocator& alloc) : SegmentedVector(alloc) {
+        if (alloc_ == other.alloc_) {
+            segments_ = std::exchange(other.segments_, {});
+            size_ = std::exchange(other.size_, 0);
+        }
+        else {
+            Reserve(other.GetSize());
+            for (Type& item : other) {
+                PushBack(std::move(item));
+            }
+            other.Clear();
+        }
+    }
+
+    // Аллокатор перенимается у rhs, только если он распространяется при копирующем присваивании
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value) {
+                Adopt_(SegmentedVector(rhs, rhs.alloc_));
+            }
+            else {
+                SegmentedVector copy(rhs, alloc_);
+                swap(copy);
+            }
+        }
+        return *this;
+    }
+
+    // Если аллокатор не распространяется при перемещающем присваивании и аллокаторы не равны,
+    // элементы rhs перемещаются по одному в сегменты, выделенные аллокатором этого вектора
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept(
+        AllocatorTraits::propagate_on_container_move_assignment::value || AllocatorTraits::is_always_equal::value) {
+        if (this != &rhs) {
+            if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+                Adopt_(std::move(rhs));
+            }
+            else {
+                SegmentedVector moved(std::move(rhs), alloc_);
+                swap(moved);
+            }
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        ReleaseSegments_();
+    }
+
+    // Добавляет элемент в конец вектора. Существующие элементы не перемещаются
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Создает элемент в конце вектора из аргументов args
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        const auto position = Index::Locate(size_);
+        if (position.segment >= Index::kMaxSegments) {
+            throw std::length_error("SegmentedVector is too long");
+        }
+        if (!segments_[position.segment]) {
+            segments_[position.segment] = AllocatorTraits::allocate(alloc_, Index::SegmentSize(position.segment));
+        }
+        Type* item = new (segments_[position.segment] + position.offset) Type(std::forward<Args>(args)...);
+        ++size_;
+        return *item;
+    }
+
+    // Удаляет последний элемент вектора
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        std::destroy_at(&(*this)[size_ - 1]);
+        --size_;
+    }
+
+    // Выделяет сегменты под capacity элементов
+    void Reserve(size_t capacity) {
+        for (size_t segment = 0; segment < Index::SegmentCount(capacity); ++segment) {
+            if (!segments_[segment]) {
+                segments_[segment] = AllocatorTraits::allocate(alloc_, Index::SegmentSize(segment));
+            }
+        }
+    }
+
+    // Обменивает значение с другим вектором.
+    // Если аллокатор не распространяется при обмене, аллокаторы векторов должны быть равны
+    void swap(SegmentedVector& other) noexcept {
+        if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        }
+        else {
+            assert(alloc_ == other.alloc_);
+        }
+        std::swap(segments_, other.segments_);
+        std::swap(size_, other.size_);
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает количество элементов, под которые выделены сегменты
+    size_t GetCapacity() const noexcept {
+        size_t segments = 0;
+        while (segments < Index::kMaxSegments && segments_[segments]) {
+            ++segments;
+        }
+        return Index::SegmentBegin(segments);
+    }
+
+    // Возвращает копию аллокатора
+    Allocator GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        const auto position = Index::Locate(index);
+        return segments_[position.segment][position.offset];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        const auto position = Index::Locate(index);
+        return segments_[position.segment][position.offset];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("index is out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index is out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Разрушает все элементы, сохраняя выделенные сегменты
+    void Clear() noexcept {
+        for (size_t segment = 0; segment < Index::SegmentCount(size_); ++segment) {
+            const size_t count = std::min(Index::SegmentSize(segment), size_ - Index::SegmentBegin(segment));
+            std::destroy_n(segments_[segment], count);
+        }
+        size_ = 0;
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    [[no_unique_address]] Allocator alloc_;
+    // Сегменты выделяются по порядку: за первым отсутствующим сегментом выделенных нет
+    std::array<Type*, Index::kMaxSegments> segments_{};
+    size_t size_ = 0;
+
+    // Разрушает элементы и освобождает все сегменты
+    void ReleaseSegments_() noexcept {
+        Clear();
+        for (size_t segment = 0; segment < Index::kMaxSegments && segments_[segment]; ++segment) {
+            AllocatorTraits::deallocate(alloc_, segments_[segment], Index::SegmentSize(segment));
+            segments_[segment] = nullptr;
+        }
+    }
+
+    // Заменяет сегменты и аллокатор сегментами и аллокатором other независимо от правил распространения
+    void Adopt_(SegmentedVector&& other) noexcept {
+        ReleaseSegments_();
+        alloc_ = std::move(other.alloc_);
+        segments_ = std::exchange(other.segments_, {});
+        size_ = std::exchange(other.size_, 0);
+    }
+};
+
+template <typename Type, typename Allocator, size_t FirstSegmentSize>
+inline bool operator==(const SegmentedVector<Type, Allocator, FirstSegmentSize>& lhs,
+    const SegmentedVector<Type, Allocator, FirstSegmentSize>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, typename Allocator, size_t FirstSegmentSize>
+inline bool operator!=(const SegmentedVector<Type, Allocator, FirstSegmentSize>& lhs,
+    const SegmentedVector<Type, Allocator, FirstSegmentSize>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator, size_t FirstSegmentSize>
+inline bool operator<(const SegmentedVector<Type, Allocator, FirstSegmentSize>& lhs,
+    const SegmentedVector<Type, Allocator, FirstSegmentSize>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename Allocator, size_t FirstSegmentSize>
+inline bool operator>(const SegmentedVector<Type, Allocator, FirstSegmentSize>& lhs,
+    const SegmentedVector<Type, Allocator, FirstSegmentSize>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator, size_t FirstSegmentSize>
+inline bool operator<=(const SegmentedVector<Type, Allocator, FirstSegmentSize>& lhs,
+    const SegmentedVector<Type, Allocator, FirstSegmentSize>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <typename Type, typename Allocator, size_t FirstSegmentSize>
+inline bool operator>=(const SegmentedVector<Type, Allocator, FirstSegmentSize>& lhs,
+    const SegmentedVector<Type, Allocator, FirstSegmentSize>& rhs) {
+    return !(lhs < rhs);
+}
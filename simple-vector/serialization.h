@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "simple_vector.h"
+
+// Точка расширения для сериализации нетривиально копируемых типов. Специализация должна предоставлять
+//     static void Write(BinaryWriter& writer, const Type& value);
+//     static Type Read(BinaryReader& reader);
+// Тривиально копируемые типы сериализуются побайтово и специализации не требуют
+template <typename Type, typename = void>
+struct SerializeTraits;
+
+// Параметры Serialize
+struct SerializeOptions {
+    // Дописывать ли после данных контрольную сумму, которую Deserialize проверяет
+    bool checksum = false;
+};
+
+// Заголовок потока вектора. element_size равен sizeof элемента для побайтовой записи
+// и нулю для записи через SerializeTraits
+struct StreamHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t flags;
+    uint64_t element_size;
+    uint64_t count;
+};
+
+inline constexpr char kStreamMagic[4] = { 'S', 'V', 'S', 'T' };
+inline constexpr uint32_t kStreamVersion = 1;
+inline constexpr uint32_t kStreamByteOrder = 0x01020304;
+inline constexpr uint32_t kStreamChecksumFlag = 1;
+
+namespace detail {
+
+    // Потоковая 64-битная контрольная сумма: байты объединяются в 64-битные слова,
+    // каждое из которых перемешивается умножением. Результат не зависит от того, какими порциями поданы данные
+    class Checksum {
+    public:
+        void Update(const void* data, size_t bytes) noexcept {
+            const auto* p = static_cast<const unsigned char*>(data);
+            while (pending_size_ != 0 && bytes != 0) {
+                AppendPending_(*p++);
+                --bytes;
+            }
+            for (; bytes >= sizeof(uint64_t); bytes -= sizeof(uint64_t), p += sizeof(uint64_t)) {
+                uint64_t word;
+                std::memcpy(&word, p, sizeof(word));
+                Mix_(word);
+            }
+            while (bytes-- != 0) {
+                AppendPending_(*p++);
+            }
+        }
+
+        uint64_t Get() const noexcept {
+            uint64_t hash = hash_;
+            if (pending_size_ != 0) {
+                uint64_t word = 0;
+                std::memcpy(&word, pending_, pending_size_);
+                hash = (hash ^ word ^ (pending_size_ << 56)) * kPrime;
+            }
+            return hash ^ (hash >> 29);
+        }
+
+    private:
+        static constexpr uint64_t kPrime = 0x100000001b3;
+
+        uint64_t hash_ = 0xcbf29ce484222325;
+        unsigned char pending_[sizeof(uint64_t)] = {};
+        uint64_t pending_size_ = 0;
+
+        void Mix_(uint64_t word) noexcept {
+            hash_ = (hash_ ^ word) * kPrime;
+            hash_ ^= hash_ >> 32;
+        }
+
+        void AppendPending_(unsigned char byte) noexcept {
+            // Индекс всегда меньше sizeof(uint64_t): маска лишь подсказывает это GCC, который иначе
+            // выдает ложное предупреждение -Wstringop-overflow при -O3
+            pending_[pending_size_++ % sizeof(uint64_t)] = byte;
+            if (pending_size_ == sizeof(uint64_t)) {
+                uint64_t word;
+                std::memcpy(&word, pending_, sizeof(word));
+                Mix_(word);
+                pending_size_ = 0;
+            }
+        }
+    };
+
+    template <typename Type>
+    inline constexpr bool kBulkSerializable = std::is_trivially_copyable_v<Type>;
+
+    // Числа элементов и символов берутся из потока и не заслуживают доверия, поэтому память под них
+    // заранее выделяется не более чем на kStreamReserveBytes (строки на kStreamChunkBytes), если поток
+    // не подтверждает наличие данных, а дальше растет по мере чтения: поврежденный заголовок приводит
+    // к ошибке об обрыве потока, а не к выделению гигабайт
+    inline constexpr size_t kStreamChunkBytes = 1 << 20;
+    inline constexpr size_t kStreamReserveBytes = 64 << 20;
+
+}
+
+// Буферизованная запись в std::ostream для сериализации: мелкие записи собираются в буфер на 64 КиБ,
+// крупные передаются потоку одним вызовом write в обход буфера. Ведет контрольную сумму записанного
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream& out) : out_(out), buffer_(new char[kBufferSize]) {
+    }
+
+    BinaryWriter(const BinaryWriter&) = delete;
+    BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+    // Записывает bytes байт из data
+    void WriteBytes(const void* data, size_t bytes) {
+        if (bytes == 0) {
+            return;
+        }
+        checksum_.Update(data, bytes);
+        if (bytes >= kBufferSize) {
+            Flush();
+            Put_(data, bytes);
+        }
+        else {
+            if (used_ + bytes > kBufferSize) {
+                Flush();
+            }
+            std::memcpy(buffer_.get() + used_, data, bytes);
+            used_ += bytes;
+        }
+    }
+
+    // Записывает объектное представление тривиально копируемого значения
+    template <typename Type>
+    void Write(const Type& value) {
+        static_assert(std::is_trivially_copyable_v<Type>, "Type must be trivially copyable");
+        WriteBytes(&value, sizeof(value));
+    }
+
+    // Возвращает контрольную сумму записанных байт
+    uint64_t GetChecksum() const noexcept {
+        return checksum_.Get();
+    }
+
+    // Передает буферизованные байты потоку
+    void Flush() {
+        Put_(buffer_.get(), used_);
+        used_ = 0;
+    }
+
+private:
+    static constexpr size_t kBufferSize = 64 << 10;
+
+    std::ostream& out_;
+    size_t used_ = 0;
+    detail::Checksum checksum_;
+    // Буфер в куче, чтобы писатель не занимал 64 КиБ стека
+    std::unique_ptr<char[]> buffer_;
+
+    void Put_(const void* data, size_t bytes) {
+        if (bytes != 0 && !out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes))) {
+            throw std::runtime_error("cannot write SimpleVector stream");
+        }
+    }
+};
+
+// Чтение из std::istream для десериализации. Байты берутся прямо из буфера потока (std::streambuf::sgetn),
+// поэтому читается ровно записанное представление и следующие за ним данные остаются в потоке,
+// а крупные блоки копируются сразу в память получателя. Ведет контрольную сумму прочитанного
+class BinaryReader {
+public:
+    explicit BinaryReader(std::istream& in) : in_(in) {
+    }
+
+    BinaryReader(const BinaryReader&) = delete;
+    BinaryReader& operator=(const BinaryReader&) = delete;
+
+    // Читает bytes байт в data. Выбрасывает std::runtime_error, если поток закончился раньше
+    void ReadBytes(void* data, size_t bytes) {
+        if (bytes == 0) {
+            return;
+        }
+        std::streambuf* buffer = in_.rdbuf();
+        if (!buffer || static_cast<size_t>(buffer->sgetn(static_cast<char*>(data), static_cast<std::streamsize>(bytes))) != bytes) {
+            in_.setstate(std::ios::eofbit | std::ios::failbit);
+            throw std::runtime_error("SimpleVector stream is truncated");
+        }
+        checksum_.Update(data, bytes);
+    }
+
+    // Читает объектное представление тривиально копируемого значения
+    template <typename Type>
+    Type Read() {
+        static_assert(std::is_trivially_copyable_v<Type>, "Type must be trivially copyable");
+        Type value;
+        ReadBytes(&value, sizeof(value));
+        return value;
+    }
+
+    // Возвращает число байт, которые заведомо можно прочитать из потока: для потоков с позиционированием
+    // (файлы, строки) это остаток до конца, для остальных только байты, уже доступные в буфере потока.
+    // Позиция чтения не меняется
+    uint64_t GetRemainingBytes() {
+        std::streambuf* buffer = in_.rdbuf();
+        if (!buffer) {
+            return 0;
+        }
+        const std::streampos current = buffer->pubseekoff(0, std::ios::cur, std::ios::in);
+        if (current != std::streampos(-1)) {
+            const std::streampos end = buffer->pubseekoff(0, std::ios::end, std::ios::in);
+            if (buffer->pubseekpos(current, std::ios::in) != current) {
+                in_.setstate(std::ios::failbit);
+                throw std::runtime_error("cannot restore SimpleVector stream position");
+            }
+            if (end != std::streampos(-1) && end >= current) {
+                return static_cast<uint64_t>(end - current);
+            }
+        }
+        return static_cast<uint64_t>(std::max<std::streamsize>(0, buffer->in_avail()));
+    }
+
+    // Возвращает контрольную сумму прочитанных байт
+    uint64_t GetChecksum() const noexcept {
+        return checksum_.Get();
+    }
+
+private:
+    std::istream& in_;
+    detail::Checksum checksum_;
+};
+
+// Строки записываются длиной и символами. Длина из потока не проверяется заранее,
+// поэтому символы читаются порциями с ростом строки по мере чтения
+template <typename Char, typename CharTraits, typename Allocator>
+struct SerializeTraits<std::basic_string<Char, CharTraits, Allocator>> {
+    static void Write(BinaryWriter& writer, const std::basic_string<Char, CharTraits, Allocator>& value) {
+        writer.Write<uint64_t>(value.size());
+        writer.WriteBytes(value.data(), value.size() * sizeof(Char));
+    }
+
+    static std::basic_string<Char, CharTraits, Allocator> Read(BinaryReader& reader) {
+        constexpr size_t kChunk = std::max<size_t>(1, detail::kStreamChunkBytes / sizeof(Char));
+        const uint64_t size = reader.Read<uint64_t>();
+        std::basic_string<Char, CharTraits, Allocator> value;
+        while (value.size() < size) {
+            const size_t done = value.size();
+            const size_t chunk = static_cast<size_t>(std::min<uint64_t>(kChunk, size - done));
+            value.resize(done + chunk);
+            reader.ReadBytes(value.data() + done, chunk * sizeof(Char));
+        }
+        return value;
+    }
+};
+
+// Записывает вектор в поток out: заголовок StreamHeader, элементы и, если задано в options, контрольную сумму.
+// Тривиально копируемые элементы записываются одним блоком, остальные через SerializeTraits<Type>::Write.
+// Выбрасывает std::runtime_error при ошибке записи
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void Serialize(std::ostream& out, const SimpleVector<Type, Allocator, GrowthPolicy>& vector, SerializeOptions options = {}) {
+    StreamHeader header{};
+    std::memcpy(header.magic, kStreamMagic, sizeof(header.magic));
+    header.version = kStreamVersion;
+    header.byte_order = kStreamByteOrder;
+    header.flags = options.checksum ? kStreamChecksumFlag : 0;
+    header.element_size = detail::kBulkSerializable<Type> ? sizeof(Type) : 0;
+    header.count = vector.GetSize();
+
+    BinaryWriter writer(out);
+    writer.Write(header);
+    if constexpr (detail::kBulkSerializable<Type>) {
+        writer.WriteBytes(vector.begin(), vector.GetSize() * sizeof(Type));
+    }
+    else {
+        for (const Type& item : vector) {
+            SerializeTraits<Type>::Write(writer, item);
+        }
+    }
+    if (options.checksum) {
+        writer.Write(writer.GetChecksum());
+    }
+    writer.Flush();
+}
+
+// Заменяет содержимое vector элементами, прочитанными из потока in.
+// Если поток подтверждает, что в нем есть все данные тривиально копируемых элементов (файлы и строки
+// позволяют узнать остаток), вместимость резервируется сразу по числу элементов из заголовка.
+// Иначе заголовку нельзя доверять: резервируется не более 64 МиБ, чтобы поврежденный заголовок
+// не приводил к огромному выделению, а дальше вектор растет по мере чтения. Элементы читаются
+// порциями по 1 МиБ прямо в неинициализированный хвост вектора через ReserveAndAppend, поэтому память
+// не обнуляется и промежуточной копии всех данных не создается.
+// Выбрасывает std::runtime_error, если заголовок не соответствует Type, поток обрывается
+// или контрольная сумма не совпадает. При ошибке в заголовке vector не меняется, при более поздней ошибке
+// vector содержит элементы, прочитанные до нее (возможно, ни одного), и им нельзя доверять
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void Deserialize(std::istream& in, SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    BinaryReader reader(in);
+    const auto header = reader.Read<StreamHeader>();
+    if (std::memcmp(header.magic, kStreamMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("not a SimpleVector stream");
+    }
+    if (header.byte_order != kStreamByteOrder) {
+        throw std::runtime_error("SimpleVector stream was written with a different byte order");
+    }
+    if (header.version != kStreamVersion) {
+        throw std::runtime_error("unsupported SimpleVector stream version " + std::to_string(header.version));
+    }
+    if (header.element_size != (detail::kBulkSerializable<Type> ? sizeof(Type) : 0)) {
+        throw std::runtime_error("SimpleVector stream stores elements of a different type");
+    }
+
+    vector.Clear();
+    constexpr size_t kReserveLimit = std::max<size_t>(1, detail::kStreamReserveBytes / sizeof(Type));
+    bool count_confirmed = false;
+    if constexpr (detail::kBulkSerializable<Type>) {
+        count_confirmed = header.count > kReserveLimit && header.count <= reader.GetRemainingBytes() / sizeof(Type);
+    }
+    vector.Reserve(static_cast<size_t>(count_confirmed ? header.count : std::min<uint64_t>(header.count, kReserveLimit)));
+    if constexpr (detail::kBulkSerializable<Type>) {
+        constexpr size_t kChunk = std::max<size_t>(1, detail::kStreamChunkBytes / sizeof(Type));
+        for (uint64_t done = 0; done < header.count;) {
+            const size_t chunk = static_cast<size_t>(std::min<uint64_t>(kChunk, header.count - done));
+            done += vector.ReserveAndAppend(chunk, [&reader](Type* tail, size_t count) {
+                reader.ReadBytes(tail, count * sizeof(Type));
+                return count;
+            });
+        }
+    }
+    else {
+        for (uint64_t i = 0; i < header.count; ++i) {
+            vector.PushBack(SerializeTraits<Type>::Read(reader));
+        }
+    }
+    if (header.flags & kStreamChecksumFlag) {
+        const uint64_t expected = reader.GetChecksum();
+        if (reader.Read<uint64_t>() != expected) {
+            throw std::runtime_error("SimpleVector stream checksum mismatch");
+        }
+    }
+}
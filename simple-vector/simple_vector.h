@@ -1,130 +1,399 @@
 #pragma once
 
+#include "aligned_allocator.h"
 #include "array_ptr.h"
+#include "compare_kernels.h"
+#include "constexpr_support.h"
+#include "growth_policy.h"
+#include "malloc_allocator.h"
+#include "parallel.h"
+#include "relocation.h"
 
 #include <algorithm>
+#include <array>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
-template <typename Type>
+namespace detail {
+
+    // Исключает перегрузку, если Iterator не является итератором ввода
+    template <typename Iterator>
+    using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+        typename std::iterator_traits<Iterator>::iterator_category, std::input_iterator_tag>>;
+
+}
+
+// Вектор, хранящий элементы в памяти, выделенной аллокатором Allocator.
+// Распространение аллокатора при копировании, перемещении и обмене следует правилам std::allocator_traits.
+// Вместимость при нехватке места вычисляется политикой роста GrowthPolicy (см. growth_policy.h)
+template <typename Type, typename Allocator = MallocAllocator<Type>, typename GrowthPolicy = DoublingGrowth>
 class SimpleVector {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
 public:
     using Iterator = Type*;
     using ConstIterator = const Type*;
 
     SimpleVector() noexcept = default;
 
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(const Allocator& alloc) noexcept : items_(alloc) {
+    }
+
     // Создает вектор из size элементов, инициализированных значением по умолчанию
-    explicit SimpleVector(size_t size) : items_(size), size_(size), capacity_(size) {
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(size_t size, const Allocator& alloc = Allocator()) : items_(size, alloc) {
+        detail::UninitializedValueConstructN(items_.Get(), size);
+        size_ = size;
     }
 
     // Создает вектор из size элементов, инициализированных значением value
-    SimpleVector(size_t size, const Type& value) : items_(size), size_(size), capacity_(size) {
-        std::fill(begin(), end(), value);
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator()) : items_(size, alloc) {
+        detail::UninitializedFillN(items_.Get(), size, value);
+        size_ = size;
+    }
+
+    // Создает вектор из size элементов, инициализированных значением по умолчанию.
+    // Элементы создаются параллельно согласно execution, если их конструктор не выбрасывает исключений
+    SimpleVector(size_t size, const ParallelExecution& execution, const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        Type* const items = items_.Get();
+        ForEachPart_<std::is_nothrow_default_constructible_v<Type>>(items, size, execution, [items](size_t first, size_t last) {
+            std::uninitialized_value_construct(items + first, items + last);
+        });
+        size_ = size;
+    }
+
+    // Создает вектор из size элементов, инициализированных значением value.
+    // Элементы создаются параллельно согласно execution, если их копирование не выбрасывает исключений
+    SimpleVector(size_t size, const Type& value, const ParallelExecution& execution, const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        Type* const items = items_.Get();
+        ForEachPart_<std::is_nothrow_copy_constructible_v<Type>>(items, size, execution, [items, &value](size_t first, size_t last) {
+            std::uninitialized_fill(items + first, items + last, value);
+        });
+        size_ = size;
     }
 
     // Создает вектор из std::initializer_list
-    SimpleVector(std::initializer_list<Type> init) : items_(init.size()), size_(init.size()), capacity_(init.size()) {
-        std::copy(init.begin(), init.end(), begin());
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator()) : items_(init.size(), alloc) {
+        detail::UninitializedCopy(init.begin(), init.end(), items_.Get());
+        size_ = init.size();
+    }
+
+    // Создает вектор из элементов диапазона [first, last).
+    // Для прямых итераторов память выделяется один раз ровно под нужное количество элементов
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(InputIt first, InputIt last, const Allocator& alloc = Allocator()) : items_(alloc) {
+        Insert(cbegin(), first, last);
+    }
+
+    // Копия получает аллокатор, возвращаемый select_on_container_copy_construction
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other)
+        : SimpleVector(other, AllocatorTraits::select_on_container_copy_construction(other.items_.GetAllocator())) {
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other, const Allocator& alloc) : items_(other.GetSize(), alloc) {
+        detail::UninitializedCopy(other.begin(), other.end(), items_.Get());
+        size_ = other.GetSize();
     }
 
-    SimpleVector(const SimpleVector& other) : items_(other.GetSize()), size_(other.GetSize()), capacity_(other.GetSize()) {
-        std::copy(other.begin(), other.end(), begin());
+    // Копирует элементы other параллельно согласно execution, если их копирование не выбрасывает исключений
+    SimpleVector(const SimpleVector& other, const ParallelExecution& execution)
+        : items_(other.GetSize(), AllocatorTraits::select_on_container_copy_construction(other.items_.GetAllocator())) {
+        Type* const items = items_.Get();
+        const Type* const source = other.begin();
+        ForEachPart_<std::is_nothrow_copy_constructible_v<Type>>(items, other.GetSize(), execution,
+            [items, source](size_t first, size_t last) {
+                std::uninitialized_copy(source + first, source + last, items + first);
+            });
+        size_ = other.GetSize();
     }
 
-    SimpleVector& operator=(const SimpleVector& rhs) {
+    // Аллокатор перенимается у rhs, только если он распространяется при копирующем присваивании
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(const SimpleVector& rhs) {
         if (this != &rhs) {
-            auto copy(rhs);
-            swap(copy);
+            if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value) {
+                SimpleVector copy(rhs, rhs.GetAllocator());
+                Clear();
+                items_.Adopt(std::move(copy.items_));
+                size_ = std::exchange(copy.size_, 0);
+            }
+            else {
+                SimpleVector copy(rhs, GetAllocator());
+                swap(copy);
+            }
         }
         return *this;
     }
 
-    SimpleVector(SimpleVector&& other) noexcept {
-        swap(other);
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other) noexcept
+        : items_(std::move(other.items_)), size_(std::exchange(other.size_, 0)) {
     }
 
-    SimpleVector& operator=(SimpleVector&& rhs) noexcept {
+    // Если аллокаторы не равны, элементы other переносятся по одному в память, выделенную аллокатором alloc
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other, const Allocator& alloc) : items_(alloc) {
+        if (alloc == other.GetAllocator()) {
+            items_ = std::move(other.items_);
+        }
+        else {
+            ArrayPtr<Type, Allocator> new_items(other.GetSize(), alloc);
+            UninitializedRelocate(other.begin(), other.end(), new_items.Get());
+            items_ = std::move(new_items);
+        }
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    // Если аллокатор не распространяется при перемещающем присваивании и аллокаторы не равны,
+    // элементы rhs переносятся по одному в память, выделенную аллокатором этого вектора
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(SimpleVector&& rhs) noexcept(
+        AllocatorTraits::propagate_on_container_move_assignment::value || AllocatorTraits::is_always_equal::value) {
         if (this != &rhs) {
-            items_ = std::move(rhs.items_);
-            size_ = std::exchange(rhs.size_, 0);
-            capacity_ = std::exchange(rhs.capacity_, 0);
+            if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+                Clear();
+                items_ = std::move(rhs.items_);
+                size_ = std::exchange(rhs.size_, 0);
+            }
+            else {
+                SimpleVector moved(std::move(rhs), GetAllocator());
+                swap(moved);
+            }
         }
         return *this;
     }
 
+    SIMPLE_VECTOR_CONSTEXPR ~SimpleVector() {
+        std::destroy(begin(), end());
+    }
+
     // Добавляет элемент в конец вектора
-    // При нехватке места увеличивает вдвое вместимость вектора
-    void PushBack(const Type& item) {
-        Insert_(end(), item);
+    // При нехватке места увеличивает вместимость вектора согласно политике роста
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        Emplace_(end(), item);
     }
 
-    void PushBack(Type&& item) {
-        Insert_(end(), std::move(item));
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item) {
+        Emplace_(end(), std::move(item));
+    }
+
+    // Создает элемент в конце вектора непосредственно в его памяти из аргументов args.
+    // Аргументы могут ссылаться на элементы самого вектора
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        return *Emplace_(end(), std::forward<Args>(args)...);
     }
 
     // Вставляет элемент в указанной позиции
-    Iterator Insert(ConstIterator pos, const Type& value) {
-        return Insert_(const_cast<Iterator>(pos), value);
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace_(const_cast<Iterator>(pos), value);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace_(const_cast<Iterator>(pos), std::move(value));
+    }
+
+    // Вставляет count копий value в указанной позиции.
+    // Память перераспределяется не более одного раза, хвост сдвигается один раз
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        assert(cbegin() <= pos && pos <= cend());
+
+        const size_t index = pos - cbegin();
+        if (count != 0) {
+            // value может ссылаться на элемент вектора, который переместится при сдвиге хвоста
+            const Type copy(value);
+            InsertGap_(index, count, [&copy, count](Type* gap) {
+                detail::UninitializedFillN(gap, count, copy);
+            });
+        }
+        return begin() + index;
+    }
+
+    // Вставляет элементы диапазона [first, last) в указанной позиции. Диапазон не должен ссылаться на элементы вектора.
+    // Для прямых итераторов итоговый размер вычисляется заранее: память перераспределяется не более одного раза,
+    // а хвост сдвигается один раз. Элементы из итераторов ввода добавляются в конец с амортизированным ростом
+    // и затем переставляются на место
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        assert(cbegin() <= pos && pos <= cend());
+
+        const size_t index = pos - cbegin();
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (count != 0) {
+                InsertGap_(index, count, [&first, &last](Type* gap) {
+                    detail::UninitializedCopy(first, last, gap);
+                });
+            }
+        }
+        else {
+            const size_t old_size = size_;
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+        }
+        return begin() + index;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, std::initializer_list<Type> init) {
+        return Insert(pos, init.begin(), init.end());
+    }
+
+    // Добавляет в конец вектора элементы диапазона range (контейнера или массива).
+    // Диапазон не должен ссылаться на элементы вектора
+    template <typename Range>
+    SIMPLE_VECTOR_CONSTEXPR void Append(const Range& range) {
+        Insert(cend(), std::begin(range), std::end(range));
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Append(std::initializer_list<Type> init) {
+        Insert(cend(), init.begin(), init.end());
     }
 
-    Iterator Insert(ConstIterator pos, Type&& value) {
-        return Insert_(const_cast<Iterator>(pos), std::move(value));
+    // Создает элемент в указанной позиции из аргументов args.
+    // Аргументы могут ссылаться на элементы самого вектора
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
+        return Emplace_(const_cast<Iterator>(pos), std::forward<Args>(args)...);
     }
 
     // Удаляет последний элемент вектора
-    void PopBack() noexcept {
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
         assert(!IsEmpty());
         --size_;
+        std::destroy_at(end());
     }
 
     // Удаляет элемент вектора в указанной позиции
-    Iterator Erase(ConstIterator pos) {
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
         assert(cbegin() <= pos && pos < cend());
 
         const Iterator it = const_cast<Iterator>(pos);
-        std::move(it + 1, end(), it);
-        --size_;
+        detail::RecordVectorEvent<Type>(VectorEvent::kEraseShift, end() - it - 1);
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            std::destroy_at(it);
+            RelocateOverlapping(it + 1, end(), it);
+            --size_;
+        }
+        else {
+            std::move(it + 1, end(), it);
+            PopBack();
+        }
+
+        return it;
+    }
+
+    // Удаляет элементы вектора в диапазоне [first, last). Хвост сдвигается один раз.
+    // Возвращает итератор на элемент, следовавший за удаленными
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(cbegin() <= first && first <= last && last <= cend());
+
+        const Iterator first_it = const_cast<Iterator>(first);
+        const Iterator last_it = const_cast<Iterator>(last);
+        if (first_it != last_it) {
+            detail::RecordVectorEvent<Type>(VectorEvent::kEraseShift, end() - last_it);
+            if constexpr (IsTriviallyRelocatableV<Type>) {
+                std::destroy(first_it, last_it);
+                RelocateOverlapping(last_it, end(), first_it);
+            }
+            else {
+                const Iterator new_end = std::move(last_it, end(), first_it);
+                std::destroy(new_end, end());
+            }
+            size_ -= last_it - first_it;
+        }
+
+        return first_it;
+    }
+
+    // Удаляет элемент вектора в указанной позиции за O(1), перенося на его место последний элемент.
+    // Порядок остальных элементов не сохраняется. Возвращает итератор на элемент, занявший позицию pos
+    SIMPLE_VECTOR_CONSTEXPR Iterator UnorderedErase(ConstIterator pos) {
+        assert(cbegin() <= pos && pos < cend());
+
+        const Iterator it = const_cast<Iterator>(pos);
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            std::destroy_at(it);
+            --size_;
+            if (it != end()) {
+                UninitializedRelocate(end(), end() + 1, it);
+            }
+        }
+        else {
+            if (it != end() - 1) {
+                *it = std::move(*(end() - 1));
+            }
+            PopBack();
+        }
 
         return it;
     }
 
-    // Обменивает значение с другим вектором
-    void swap(SimpleVector& other) noexcept {
+    // Обменивает значение с другим вектором.
+    // Если аллокатор не распространяется при обмене, аллокаторы векторов должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR void swap(SimpleVector& other) noexcept {
         items_.swap(other.items_);
         std::swap(size_, other.size_);
-        std::swap(capacity_, other.capacity_);
     }
 
     // Возвращает количество элементов в массиве
-    size_t GetSize() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
         return size_;
     }
 
     // Возвращает вместимость массива
-    size_t GetCapacity() const noexcept {
-        return capacity_;
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacity() const noexcept {
+        return items_.GetCapacity();
+    }
+
+    // Возвращает копию аллокатора
+    SIMPLE_VECTOR_CONSTEXPR Allocator GetAllocator() const noexcept {
+        return items_.GetAllocator();
     }
 
     // Сообщает, пустой ли массив
-    bool IsEmpty() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept {
         return size_ == 0;
     }
 
+    // Сообщает, выровнено ли начало массива по границе alignment байт.
+    // По умолчанию проверяется выравнивание, которое гарантирует аллокатор
+    bool IsAligned(size_t alignment = detail::kAllocatorAlignment<Allocator>) const noexcept {
+        return detail::IsAlignedPointer(items_.Get(), alignment);
+    }
+
+    // Возвращает указатель на начало массива с подсказкой компилятору, что он выровнен по Alignment байт,
+    // чтобы векторные циклы использовали выровненные загрузки без пролога. Начало массива должно быть выровнено
+    template <size_t Alignment = detail::kAllocatorAlignment<Allocator>>
+    Type* AlignedData() noexcept {
+        assert(IsAligned(Alignment));
+        return detail::AssumeAligned<Alignment>(items_.Get());
+    }
+
+    template <size_t Alignment = detail::kAllocatorAlignment<Allocator>>
+    const Type* AlignedData() const noexcept {
+        assert(IsAligned(Alignment));
+        return detail::AssumeAligned<Alignment>(static_cast<const Type*>(items_.Get()));
+    }
+
     // Возвращает ссылку на элемент с индексом index
-    Type& operator[](size_t index) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
         return items_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
-    const Type& operator[](size_t index) const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
         return items_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    Type& At(size_t index) {
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index) {
         if (index >= size_) {
             throw std::out_of_range("index is out of range");
         }
@@ -133,7 +402,7 @@ public:
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    const Type& At(size_t index) const {
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const {
         if (index >= size_) {
             throw std::out_of_range("index is out of range");
         }
@@ -141,133 +410,390 @@ public:
     }
 
     // Обнуляет размер массива, не изменяя его вместимость
-    void Clear() noexcept {
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        std::destroy(begin(), end());
         size_ = 0;
     }
 
     // Изменяет размер массива.
     // При увеличении размера новые элементы получают значение по умолчанию для типа Type
-    void Resize(size_t new_size) {
-        if (new_size > capacity_) {
-            const size_t new_capacity = std::max(new_size, capacity_ * 2);
-            ArrayPtr<Type> new_items(new_capacity);
-            std::move(begin(), end(), new_items.Get());
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            std::destroy(begin() + new_size, end());
+            size_ = new_size;
+            return;
+        }
 
-            items_ = std::move(new_items);
-            capacity_ = new_capacity;
+        if (new_size > GetCapacity()) {
+            Reallocate_(NextCapacity_(new_size));
         }
-        else {
-            // Заполняем диапазон [size, new_size) значениями по умолчанию
-            for (size_t i = size_; i < new_size; ++i) {
-                items_[i] = Type();
-            }
+
+        // Создаем в диапазоне [size, new_size) элементы со значениями по умолчанию
+        detail::UninitializedValueConstructN(end(), new_size - size_);
+        size_ = new_size;
+    }
+
+    // Изменяет размер массива, создавая новые элементы параллельно согласно execution,
+    // если их конструктор не выбрасывает исключений
+    void Resize(size_t new_size, const ParallelExecution& execution) {
+        if (new_size <= size_) {
+            Resize(new_size);
+            return;
         }
 
+        if (new_size > GetCapacity()) {
+            Reallocate_(NextCapacity_(new_size));
+        }
+
+        Type* const tail = end();
+        ForEachPart_<std::is_nothrow_default_constructible_v<Type>>(tail, new_size - size_, execution,
+            [tail](size_t first, size_t last) {
+                std::uninitialized_value_construct(tail + first, tail + last);
+            });
         size_ = new_size;
     }
 
-    // Изменяет вместимость массива
-    void Reserve(size_t new_capacity) {
-        if (new_capacity <= capacity_) {
+    // Изменяет размер массива, создавая новые элементы инициализацией по умолчанию.
+    // Для тривиальных типов новые элементы остаются неинициализированными и не обнуляются,
+    // поэтому их необходимо перезаписать до чтения (например, буфер для read/recv)
+    void ResizeForOverwrite(size_t new_size) {
+        if (new_size <= size_) {
+            Resize(new_size);
             return;
         }
 
-        ArrayPtr<Type> new_items(new_capacity);
-        std::move(begin(), end(), new_items.Get());
+        if (new_size > GetCapacity()) {
+            Reallocate_(NextCapacity_(new_size));
+        }
+
+        std::uninitialized_default_construct(end(), begin() + new_size);
+        size_ = new_size;
+    }
+
+    // Обеспечивает место под max_count элементов в конце массива и передает его неинициализированным
+    // вызову writer(tail, max_count). writer записывает элементы в начало [tail, tail + max_count)
+    // и возвращает их число, которое добавляется к размеру вектора. Вместимость растет согласно политике роста.
+    // Если writer выбрасывает исключение, размер не изменяется. Возвращает число добавленных элементов
+    template <typename Writer>
+    size_t ReserveAndAppend(size_t max_count, Writer&& writer) {
+        static_assert(std::is_trivially_copyable_v<Type> && std::is_trivially_destructible_v<Type>,
+            "ReserveAndAppend requires a trivially copyable element type");
+
+        if (max_count > GetCapacity() - size_) {
+            Reallocate_(NextCapacity_(size_ + max_count));
+        }
+
+        const size_t written = std::forward<Writer>(writer)(end(), max_count);
+        assert(written <= max_count);
+        size_ += written;
+        return written;
+    }
+
+    // Присваивает всем элементам значение value
+    SIMPLE_VECTOR_CONSTEXPR void Fill(const Type& value) {
+        std::fill(begin(), end(), value);
+    }
+
+    // Присваивает всем элементам значение value параллельно согласно execution,
+    // если присваивание не выбрасывает исключений
+    void Fill(const Type& value, const ParallelExecution& execution) {
+        // value может ссылаться на элемент вектора, который перезапишет другой поток
+        const Type copy(value);
+        Type* const items = begin();
+        ForEachPart_<std::is_nothrow_copy_assignable_v<Type>>(items, size_, execution, [items, &copy](size_t first, size_t last) {
+            std::fill(items + first, items + last, copy);
+        });
+    }
+
+    // Изменяет вместимость массива
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate_(new_capacity);
+        }
+    }
 
-        items_ = std::move(new_items);
-        capacity_ = new_capacity;
+    // Уменьшает вместимость массива до его размера, возвращая лишнюю память аллокатору.
+    // Пустой вектор освобождает память полностью
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkToFit() {
+        if (GetCapacity() > size_) {
+            Reallocate_(size_);
+        }
     }
 
     // Возвращает итератор на начало массива
-    Iterator begin() noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept {
         return items_.Get();
     }
 
     // Возвращает итератор на элемент, следующий за последним
-    Iterator end() noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept {
         return begin() + size_;
     }
 
     // Возвращает константный итератор на начало массива
-    ConstIterator begin() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept {
         return items_.Get();
     }
 
     // Возвращает итератор на элемент, следующий за последним
-    ConstIterator end() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept {
         return begin() + size_;
     }
 
     // Возвращает константный итератор на начало массива
-    ConstIterator cbegin() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept {
         return items_.Get();
     }
 
     // Возвращает итератор на элемент, следующий за последним
-    ConstIterator cend() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept {
         return begin() + size_;
     }
 
 private:
-    ArrayPtr<Type> items_;
+    // Память под GetCapacity() элементов, из которых живыми являются только первые size_
+    ArrayPtr<Type, Allocator> items_;
     size_t size_ = 0;
-    size_t capacity_ = 0;
 
-    // Вставляет значение value в позицию pos.
-    // Возвращает итератор на вставленное значение
-    template<typename T>
-    Iterator Insert_(Iterator pos, T&& value) {
+    // Переносит элементы в новый массив вместимостью new_capacity
+    SIMPLE_VECTOR_CONSTEXPR void Reallocate_(size_t new_capacity) {
+        detail::RecordVectorEvent<Type>(VectorEvent::kRelocation, size_);
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            items_.Reallocate(new_capacity, size_);
+        }
+        else {
+            ArrayPtr<Type, Allocator> new_items(new_capacity, GetAllocator());
+            UninitializedRelocate(begin(), end(), new_items.Get());
+            items_ = std::move(new_items);
+        }
+    }
+
+    // Вызывает action(first, last) для частей диапазона [0, count) элементов, начинающихся с items:
+    // параллельно, если Nothrow, иначе один раз для всего диапазона в вызывающем потоке
+    template <bool Nothrow, typename Action>
+    static void ForEachPart_(const Type* items, size_t count, const ParallelExecution& execution, Action action) {
+        if constexpr (Nothrow) {
+            detail::ParallelFor(items, count, sizeof(Type), execution, action);
+        }
+        else {
+            action(size_t{ 0 }, count);
+        }
+    }
+
+    // Вставляет count элементов в позицию index: construct(gap) создает их в неинициализированном промежутке gap.
+    // Память перераспределяется не более одного раза, хвост сдвигается один раз.
+    // Если вместимости не хватает или перенос элементов может выбросить исключение, новые элементы создаются
+    // в новом буфере до переноса старых, поэтому при исключении вектор не изменяется
+    template <typename Construct>
+    SIMPLE_VECTOR_CONSTEXPR void InsertGap_(size_t index, size_t count, Construct construct) {
+        detail::RecordVectorEvent<Type>(VectorEvent::kInsertShift, size_ - index);
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            if (size_ + count > GetCapacity()) {
+                Reallocate_(NextCapacity_(size_ + count));
+            }
+        }
+        else if (size_ + count > GetCapacity() || !std::is_nothrow_move_constructible_v<Type>) {
+            // Сдвиг хвоста на месте мог бы прерваться исключением, оставив в векторе неинициализированные ячейки
+            const size_t new_capacity = size_ + count > GetCapacity() ? NextCapacity_(size_ + count) : GetCapacity();
+            ArrayPtr<Type, Allocator> new_items(new_capacity, GetAllocator());
+            Type* const gap = new_items.Get() + index;
+            construct(gap);
+            detail::RecordVectorEvent<Type>(VectorEvent::kRelocation, size_);
+            try {
+                UninitializedRelocateAround(begin(), begin() + index, end(), new_items.Get(), count);
+            }
+            catch (...) {
+                std::destroy(gap, gap + count);
+                throw;
+            }
+            items_ = std::move(new_items);
+            size_ += count;
+            return;
+        }
+
+        const Iterator gap = begin() + index;
+        RelocateOverlapping(gap, end(), gap + count);
+        try {
+            construct(gap);
+        }
+        catch (...) {
+            // Возвращает хвост на место
+            RelocateOverlapping(gap + count, end() + count, gap);
+            throw;
+        }
+        size_ += count;
+    }
+
+    // Возвращает вместимость не меньше required, до которой вектор растет при нехватке места
+    SIMPLE_VECTOR_CONSTEXPR size_t NextCapacity_(size_t required) const noexcept {
+        return GrowthPolicy::NextCapacity(GetCapacity(), required, sizeof(Type));
+    }
+
+    // Создает элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace_(Iterator pos, Args&&... args) {
         assert(begin() <= pos && pos <= end());
 
         const size_t insert_index = pos - begin();
+        detail::RecordVectorEvent<Type>(VectorEvent::kInsertShift, size_ - insert_index);
 
-        if (size_ < capacity_) {
-            std::move_backward(pos, end(), end() + 1);
-            items_[insert_index] = std::forward<T>(value);
+        if (pos == end() && size_ < GetCapacity()) {
+            detail::ConstructAt(end(), std::forward<Args>(args)...);
+        }
+        else if constexpr (IsTriviallyRelocatableV<Type>) {
+            if (detail::IsConstantEvaluated()) {
+                // В константном выражении объект нельзя создать в байтовом буфере,
+                // поэтому новый элемент создается как локальная переменная и перемещается на место
+                Type item(std::forward<Args>(args)...);
+                if (size_ == GetCapacity()) {
+                    Reallocate_(NextCapacity_(size_ + 1));
+                }
+                const Iterator slot = begin() + insert_index;
+                RelocateOverlapping(slot, end(), slot + 1);
+                detail::ConstructAt(slot, std::move(item));
+            }
+            else {
+                // args могут ссылаться на элементы самого вектора, поэтому новый элемент создается
+                // во временном буфере до перераспределения памяти и сдвига хвоста
+                alignas(Type) unsigned char buffer[sizeof(Type)];
+                Type* const item = new (buffer) Type(std::forward<Args>(args)...);
+                if (size_ == GetCapacity()) {
+                    try {
+                        Reallocate_(NextCapacity_(size_ + 1));
+                    }
+                    catch (...) {
+                        std::destroy_at(item);
+                        throw;
+                    }
+                }
+
+                const Iterator slot = begin() + insert_index;
+                RelocateOverlapping(slot, end(), slot + 1);
+                UninitializedRelocate(item, item + 1, slot);
+            }
+        }
+        else if (size_ < GetCapacity() && std::is_nothrow_move_constructible_v<Type>) {
+            // args могут ссылаться на элементы хвоста, поэтому новый элемент создается до его сдвига.
+            // Последний элемент переезжает в неинициализированную ячейку, остальные сдвигаются присваиванием.
+            // Если присваивание выбросит исключение, элементы остаются живыми, но их значения не определены
+            Type item(std::forward<Args>(args)...);
+            detail::ConstructAt(end(), std::move(*(end() - 1)));
+            try {
+                std::move_backward(pos, end() - 1, end());
+                *pos = std::move(item);
+            }
+            catch (...) {
+                std::destroy_at(end());
+                throw;
+            }
         }
         else {
-            const size_t new_capacity = std::max(static_cast<size_t>(1), capacity_ * 2);
-            ArrayPtr<Type> new_items(new_capacity);
-            std::move(begin(), pos, new_items.Get());
-            new_items[insert_index] = std::forward<T>(value);
-            std::move(pos, end(), new_items.Get() + insert_index + 1);
+            // Новый элемент создается в новом буфере до переноса старых элементов.
+            // Если перенос выбросит исключение, новый элемент разрушается, а вектор не изменяется.
+            // Элементы с бросающим перемещением переносятся так и при запасе вместимости
+            const size_t new_capacity = size_ < GetCapacity() ? GetCapacity() : NextCapacity_(size_ + 1);
+            ArrayPtr<Type, Allocator> new_items(new_capacity, GetAllocator());
+            Type* const item = detail::ConstructAt(new_items.Get() + insert_index, std::forward<Args>(args)...);
+            detail::RecordVectorEvent<Type>(VectorEvent::kRelocation, size_);
+            try {
+                UninitializedRelocateAround(begin(), pos, end(), new_items.Get(), 1);
+            }
+            catch (...) {
+                std::destroy_at(item);
+                throw;
+            }
 
             items_ = std::move(new_items);
-            capacity_ = new_capacity;
         }
         ++size_;
 
-        return &items_[insert_index];
+        return begin() + insert_index;
     }
 };
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator==(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && detail::RangesEqual(lhs.begin(), rhs.begin(), lhs.GetSize());
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator!=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator<(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return detail::RangesLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator>(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return rhs < lhs;
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator<=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(lhs > rhs);
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator>=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(lhs < rhs);
 }
+
+// Удаляет из вектора элементы, удовлетворяющие предикату pred, за один проход с уплотнением.
+// Возвращает количество удаленных элементов
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Predicate>
+SIMPLE_VECTOR_CONSTEXPR size_t EraseIf(SimpleVector<Type, Allocator, GrowthPolicy>& vector, Predicate pred) {
+    const auto new_end = std::remove_if(vector.begin(), vector.end(), pred);
+    const size_t removed = vector.end() - new_end;
+    vector.Erase(new_end, vector.end());
+    return removed;
+}
+
+// Удаляет из вектора элементы, равные value, за один проход с уплотнением.
+// Возвращает количество удаленных элементов
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Value>
+SIMPLE_VECTOR_CONSTEXPR size_t Erase(SimpleVector<Type, Allocator, GrowthPolicy>& vector, const Value& value) {
+    return EraseIf(vector, [&value](const Type& item) {
+        return item == value;
+    });
+}
+
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+namespace detail {
+
+    template <auto Builder, size_t... Indexes>
+    constexpr auto FreezeToArray(std::index_sequence<Indexes...>) {
+        const auto vector = Builder();
+        using Type = std::remove_cv_t<std::remove_reference_t<decltype(*vector.begin())>>;
+        return std::array<Type, sizeof...(Indexes)>{ vector[Indexes]... };
+    }
+
+}
+
+// Вызывает constexpr-функцию Builder, строящую SimpleVector, во время компиляции и возвращает копию
+// его элементов в std::array. Память вектора в константном выражении не может дожить до выполнения
+// программы, поэтому таблица, построенная вектором, сохраняется только в виде массива. Пример:
+//     constexpr SimpleVector<int> BuildSquares() { ... }
+//     static constexpr auto kSquares = FreezeSimpleVector<BuildSquares>();  // размещается в .rodata
+template <auto Builder>
+constexpr auto FreezeSimpleVector() {
+    constexpr size_t size = Builder().GetSize();
+    return detail::FreezeToArray<Builder>(std::make_index_sequence<size>());
+}
+#endif
+
+namespace pmr {
+
+    // SimpleVector, получающий память из std::pmr::memory_resource
+    template <typename Type, typename GrowthPolicy = DoublingGrowth>
+    using SimpleVector = ::SimpleVector<Type, std::pmr::polymorphic_allocator<Type>, GrowthPolicy>;
+
+}
+
+// SimpleVector, начало массива которого выровнено по Alignment байт, а вместимость при росте
+// дополняется до кратной Alignment байтам. Пример: AlignedSimpleVector<float, 32> для загрузок AVX
+template <typename Type, size_t Alignment = 64>
+using AlignedSimpleVector = SimpleVector<Type, AlignedAllocator<Type, Alignment>, PaddedGrowth<Alignment>>;
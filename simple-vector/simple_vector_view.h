@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "compare_kernels.h"
+
+namespace detail {
+
+    // Указатель на элементы, который возвращает begin() непрерывного контейнера
+    template <typename Container>
+    using ContainerPointer = decltype(std::declval<Container&>().begin());
+
+    // Контейнер, через который SimpleVectorView<Type> обращается к элементам. Представление только для чтения
+    // обращается к константному контейнеру: так оно не выдает изменяемых ссылок и, например,
+    // не отделяет CowSimpleVector от других копий
+    template <typename Type, typename Container>
+    using ViewSource = std::conditional_t<std::is_const_v<Type>,
+        const std::remove_reference_t<Container>&, std::remove_reference_t<Container>&>;
+
+    // Сообщает, можно ли построить SimpleVectorView<Type> по контейнеру Container:
+    // begin() должен возвращать указатель, преобразуемый в Type*, а размер сообщаться через GetSize().
+    // Изменяемое представление строится только по lvalue, чтобы не ссылаться на элементы временного объекта
+    template <typename Type, typename Container, typename = void>
+    inline constexpr bool kIsViewableContainer = false;
+
+    template <typename Type, typename Container>
+    inline constexpr bool kIsViewableContainer<Type, Container, std::void_t<ContainerPointer<ViewSource<Type, Container>>,
+        decltype(std::declval<ViewSource<Type, Container>>().GetSize())>> =
+        std::is_pointer_v<ContainerPointer<ViewSource<Type, Container>>>
+        && std::is_convertible_v<ContainerPointer<ViewSource<Type, Container>>, Type*>
+        && (std::is_const_v<Type> || std::is_lvalue_reference_v<Container>);
+
+}
+
+// Невладеющее представление непрерывного диапазона элементов: указатель и размер.
+// SimpleVectorView<Type> допускает изменение элементов, SimpleVectorView<const Type> только чтение.
+// Строится по SimpleVector и другим непрерывным векторам библиотеки неявно, поэтому функция,
+// принимающая SimpleVectorView<const Type> по значению, принимает и вектор целиком без копирования.
+// Представление не продлевает жизнь элементов и становится недействительным, если вектор перераспределил память
+template <typename Type>
+class SimpleVectorView {
+    using Value = std::remove_const_t<Type>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Значение, означающее «до конца представления» в Subview
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    SimpleVectorView() noexcept = default;
+
+    // Создает представление size элементов, начиная с data
+    SimpleVectorView(Type* data, size_t size) noexcept : data_(data), size_(size) {
+    }
+
+    // Создает представление диапазона [first, last). Как и у std::span, конец не может быть
+    // преобразуемым в size_t, чтобы вызов SimpleVectorView(data, 0) выбирал конструктор с размером
+    template <typename End, typename = std::enable_if_t<
+        std::is_convertible_v<End, Type*> && !std::is_convertible_v<End, size_t>>>
+    SimpleVectorView(Type* first, End last) noexcept : data_(first), size_(static_cast<Type*>(last) - first) {
+        assert(first <= static_cast<Type*>(last));
+    }
+
+    // Создает представление всех элементов контейнера (SimpleVector, SmallSimpleVector и т. п.).
+    // Представление только для чтения получает элементы через константный контейнер
+    template <typename Container, typename = std::enable_if_t<
+        !std::is_same_v<std::remove_cv_t<std::remove_reference_t<Container>>, SimpleVectorView>
+        && detail::kIsViewableContainer<Type, Container>>>
+    SimpleVectorView(Container&& container) noexcept
+        : data_(static_cast<detail::ViewSource<Type, Container>>(container).begin())
+        , size_(container.GetSize()) {
+    }
+
+    // Возвращает указатель на первый элемент
+    Type* Data() const noexcept {
+        return data_;
+    }
+
+    // Возвращает количество элементов в представлении
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Сообщает, пустое ли представление
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index is out of range");
+        }
+        return data_[index];
+    }
+
+    // Возвращает представление не более count элементов, начиная с offset
+    // Выбрасывает исключение std::out_of_range, если offset > size
+    SimpleVectorView Subview(size_t offset, size_t count = npos) const {
+        if (offset > size_) {
+            throw std::out_of_range("offset is out of range");
+        }
+        return SimpleVectorView(data_ + offset, std::min(count, size_ - offset));
+    }
+
+    Iterator begin() const noexcept {
+        return data_;
+    }
+
+    Iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Операторы сравнения находятся поиском, зависящим от аргументов, и допускают неявное приведение,
+    // поэтому представление сравнивается и с вектором, и с представлением только для чтения
+    friend bool operator==(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return lhs.size_ == rhs.size_ && detail::RangesEqual<Value>(lhs.data_, rhs.data_, lhs.size_);
+    }
+
+    friend bool operator!=(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return detail::RangesLess<Value>(lhs.data_, lhs.size_, rhs.data_, rhs.size_);
+    }
+
+    friend bool operator>(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return !(lhs > rhs);
+    }
+
+    friend bool operator>=(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Type>
+SimpleVectorView(Type*, size_t) -> SimpleVectorView<Type>;
+
+template <typename Type>
+SimpleVectorView(Type*, Type*) -> SimpleVectorView<Type>;
+
+template <typename Container>
+SimpleVectorView(Container&&) -> SimpleVectorView<std::remove_pointer_t<detail::ContainerPointer<Container>>>;
@@ -0,0 +1,443 @@
+#pragma once
+
+#include "array_ptr.h"
+#include "compare_kernels.h"
+#include "malloc_allocator.h"
+#include "relocation.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Вектор с интерфейсом SimpleVector, хранящий до N элементов во встроенном буфере.
+// Память в куче выделяется аллокатором Allocator, только когда размер превышает N
+template <typename Type, size_t N, typename Allocator = MallocAllocator<Type>>
+class SmallSimpleVector {
+    static_assert(N > 0, "inline capacity must be positive");
+
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Количество элементов, помещающихся во встроенный буфер
+    static constexpr size_t kInlineCapacity = N;
+
+    SmallSimpleVector() noexcept = default;
+
+    explicit SmallSimpleVector(const Allocator& alloc) noexcept : heap_(alloc) {
+    }
+
+    // Создает вектор из size элементов, инициализированных значением по умолчанию
+    explicit SmallSimpleVector(size_t size, const Allocator& alloc = Allocator()) : heap_(alloc) {
+        std::uninitialized_value_construct_n(StorageFor_(size), size);
+        size_ = size;
+    }
+
+    // Создает вектор из size элементов, инициализированных значением value
+    SmallSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator()) : heap_(alloc) {
+        std::uninitialized_fill_n(StorageFor_(size), size, value);
+        size_ = size;
+    }
+
+    // Создает вектор из std::initializer_list
+    SmallSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator()) : heap_(alloc) {
+        std::uninitialized_copy(init.begin(), init.end(), StorageFor_(init.size()));
+        size_ = init.size();
+    }
+
+    // Копия получает аллокатор, возвращаемый select_on_container_copy_construction
+    SmallSimpleVector(const SmallSimpleVector& other)
+        : SmallSimpleVector(other, AllocatorTraits::select_on_container_copy_construction(other.GetAllocator())) {
+    }
+
+    SmallSimpleVector(const SmallSimpleVector& other, const Allocator& alloc) : heap_(alloc) {
+        std::uninitialized_copy(other.begin(), other.end(), StorageFor_(other.GetSize()));
+        size_ = other.GetSize();
+    }
+
+    // Аллокатор перенимается у rhs, только если он распространяется при копирующем присваивании
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs) {
+        if (this != &rhs) {
+            if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value) {
+                SmallSimpleVector copy(rhs, rhs.GetAllocator());
+                Clear();
+                heap_.Adopt(std::move(copy.heap_));
+                StealElements_(copy);
+            }
+            else {
+                SmallSimpleVector copy(rhs, GetAllocator());
+                Clear();
+                heap_ = std::move(copy.heap_);
+                StealElements_(copy);
+            }
+        }
+        return *this;
+    }
+
+    // Память в куче забирается у other целиком, элементы встроенного буфера переносятся по одному
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>)
+        : heap_(std::move(other.heap_)) {
+        StealElements_(other);
+    }
+
+    // Если аллокатор не распространяется при перемещающем присваивании и аллокаторы не равны,
+    // элементы rhs переносятся по одному в память, выделенную аллокатором этого вектора
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>
+        && (AllocatorTraits::propagate_on_container_move_assignment::value || AllocatorTraits::is_always_equal::value)) {
+        if (this != &rhs) {
+            Clear();
+            if (AllocatorTraits::propagate_on_container_move_assignment::value || GetAllocator() == rhs.GetAllocator()) {
+                heap_ = std::move(rhs.heap_);
+                StealElements_(rhs);
+            }
+            else {
+                Reserve(rhs.GetSize());
+                UninitializedRelocate(rhs.begin(), rhs.end(), begin());
+                size_ = std::exchange(rhs.size_, 0);
+            }
+        }
+        return *this;
+    }
+
+    ~SmallSimpleVector() {
+        std::destroy(begin(), end());
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вдвое вместимость вектора
+    void PushBack(const Type& item) {
+        Emplace_(end(), item);
+    }
+
+    void PushBack(Type&& item) {
+        Emplace_(end(), std::move(item));
+    }
+
+    // Создает элемент в конце вектора непосредственно в его памяти из аргументов args.
+    // Аргументы могут ссылаться на элементы самого вектора
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *Emplace_(end(), std::forward<Args>(args)...);
+    }
+
+    // Вставляет элемент в указанной позиции
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace_(const_cast<Iterator>(pos), value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace_(const_cast<Iterator>(pos), std::move(value));
+    }
+
+    // Создает элемент в указанной позиции из аргументов args.
+    // Аргументы могут ссылаться на элементы самого вектора
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        return Emplace_(const_cast<Iterator>(pos), std::forward<Args>(args)...);
+    }
+
+    // Удаляет последний элемент вектора
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        --size_;
+        std::destroy_at(end());
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    Iterator Erase(ConstIterator pos) {
+        assert(cbegin() <= pos && pos < cend());
+
+        const Iterator it = const_cast<Iterator>(pos);
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            std::destroy_at(it);
+            RelocateOverlapping(it + 1, end(), it);
+            --size_;
+        }
+        else {
+            std::move(it + 1, end(), it);
+            PopBack();
+        }
+
+        return it;
+    }
+
+    // Обменивает значение с другим вектором.
+    // Если оба вектора хранят элементы в куче, обмениваются только указатели на память.
+    // Если аллокатор не распространяется при обмене, аллокаторы векторов должны быть равны
+    void swap(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (this == &other) {
+            return;
+        }
+        if (!IsInline() && !other.IsInline()) {
+            heap_.swap(other.heap_);
+            std::swap(size_, other.size_);
+        }
+        else {
+            SmallSimpleVector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость массива
+    size_t GetCapacity() const noexcept {
+        return IsInline() ? N : heap_.GetCapacity();
+    }
+
+    // Возвращает копию аллокатора
+    Allocator GetAllocator() const noexcept {
+        return heap_.GetAllocator();
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Сообщает, хранятся ли элементы во встроенном буфере
+    bool IsInline() const noexcept {
+        return !heap_;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        return begin()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        return begin()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("index is out of range");
+        }
+        return begin()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index is out of range");
+        }
+        return begin()[index];
+    }
+
+    // Обнуляет размер массива, не изменяя его вместимость
+    void Clear() noexcept {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            std::destroy(begin() + new_size, end());
+            size_ = new_size;
+            return;
+        }
+
+        if (new_size > GetCapacity()) {
+            Reallocate_(std::max(new_size, NextCapacity_()));
+        }
+
+        // Создаем в диапазоне [size, new_size) элементы со значениями по умолчанию
+        std::uninitialized_value_construct(end(), begin() + new_size);
+        size_ = new_size;
+    }
+
+    // Изменяет вместимость массива
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate_(new_capacity);
+        }
+    }
+
+    // Возвращает итератор на начало массива
+    Iterator begin() noexcept {
+        return IsInline() ? reinterpret_cast<Type*>(inline_) : heap_.Get();
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    Iterator end() noexcept {
+        return begin() + size_;
+    }
+
+    // Возвращает константный итератор на начало массива
+    ConstIterator begin() const noexcept {
+        return IsInline() ? reinterpret_cast<const Type*>(inline_) : heap_.Get();
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    ConstIterator end() const noexcept {
+        return begin() + size_;
+    }
+
+    // Возвращает константный итератор на начало массива
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    ConstIterator cend() const noexcept {
+        return begin() + size_;
+    }
+
+private:
+    // Память в куче. Пока она не выделена, элементы хранятся во встроенном буфере inline_
+    ArrayPtr<Type, Allocator> heap_;
+    size_t size_ = 0;
+    alignas(Type) unsigned char inline_[N * sizeof(Type)];
+
+    // Возвращает память под size элементов только что созданного вектора,
+    // выделяя ее в куче, если элементы не помещаются во встроенный буфер
+    Type* StorageFor_(size_t size) {
+        if (size <= N) {
+            return reinterpret_cast<Type*>(inline_);
+        }
+        heap_ = ArrayPtr<Type, Allocator>(size, GetAllocator());
+        return heap_.Get();
+    }
+
+    // Забирает элементы other после того, как память в куче other уже передана этому вектору.
+    // Если памяти в куче у other не было, его элементы переносятся из встроенного буфера по одному
+    void StealElements_(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (IsInline()) {
+            // Во встроенном буфере не больше N элементов. Явная граница позволяет компилятору убедиться,
+            // что перенос не выходит за пределы inline_
+            Type* const source = reinterpret_cast<Type*>(other.inline_);
+            UninitializedRelocate(source, source + std::min(other.size_, N), reinterpret_cast<Type*>(inline_));
+        }
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    // Переносит элементы в память кучи вместимостью new_capacity
+    void Reallocate_(size_t new_capacity) {
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            if (!IsInline()) {
+                heap_.Reallocate(new_capacity, size_);
+                return;
+            }
+        }
+        ArrayPtr<Type, Allocator> new_items(new_capacity, GetAllocator());
+        UninitializedRelocate(begin(), end(), new_items.Get());
+        heap_ = std::move(new_items);
+    }
+
+    // Возвращает вместимость, до которой вектор растет при нехватке места
+    size_t NextCapacity_() const noexcept {
+        return GetCapacity() * 2;
+    }
+
+    // Создает элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    Iterator Emplace_(Iterator pos, Args&&... args) {
+        assert(begin() <= pos && pos <= end());
+
+        const size_t insert_index = pos - begin();
+
+        if (pos == end() && size_ < GetCapacity()) {
+            new (end()) Type(std::forward<Args>(args)...);
+        }
+        else if constexpr (IsTriviallyRelocatableV<Type>) {
+            // args могут ссылаться на элементы самого вектора, поэтому новый элемент создается
+            // во временном буфере до перераспределения памяти и сдвига хвоста
+            alignas(Type) unsigned char buffer[sizeof(Type)];
+            Type* const item = new (buffer) Type(std::forward<Args>(args)...);
+            if (size_ == GetCapacity()) {
+                try {
+                    Reallocate_(NextCapacity_());
+                }
+                catch (...) {
+                    std::destroy_at(item);
+                    throw;
+                }
+            }
+
+            const Iterator slot = begin() + insert_index;
+            RelocateOverlapping(slot, end(), slot + 1);
+            UninitializedRelocate(item, item + 1, slot);
+        }
+        else if (size_ < GetCapacity() && std::is_nothrow_move_constructible_v<Type>) {
+            // args могут ссылаться на элементы хвоста, поэтому новый элемент создается до его сдвига.
+            // Последний элемент переезжает в неинициализированную ячейку, остальные сдвигаются присваиванием.
+            // Если присваивание выбросит исключение, элементы остаются живыми, но их значения не определены
+            Type item(std::forward<Args>(args)...);
+            new (end()) Type(std::move(*(end() - 1)));
+            try {
+                std::move_backward(pos, end() - 1, end());
+                *pos = std::move(item);
+            }
+            catch (...) {
+                std::destroy_at(end());
+                throw;
+            }
+        }
+        else {
+            // Новый элемент создается в новом буфере до переноса старых элементов.
+            // Если перенос выбросит исключение, новый элемент разрушается, а вектор не изменяется.
+            // Элементы с бросающим перемещением переносятся так и при запасе вместимости
+            const size_t new_capacity = size_ < GetCapacity() ? GetCapacity() : NextCapacity_();
+            ArrayPtr<Type, Allocator> new_items(new_capacity, GetAllocator());
+            Type* const item = new (new_items.Get() + insert_index) Type(std::forward<Args>(args)...);
+            try {
+                UninitializedRelocateAround(begin(), pos, end(), new_items.Get(), 1);
+            }
+            catch (...) {
+                std::destroy_at(item);
+                throw;
+            }
+
+            heap_ = std::move(new_items);
+        }
+        ++size_;
+
+        return begin() + insert_index;
+    }
+};
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator==(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && detail::RangesEqual(lhs.begin(), rhs.begin(), lhs.GetSize());
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator!=(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator<(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return detail::RangesLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator>(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator<=(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator>=(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return !(lhs < rhs);
+}
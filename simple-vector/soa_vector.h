@@ -0,0 +1,471 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "array_ptr.h"
+#include "compare_kernels.h"
+#include "growth_policy.h"
+#include "relocation.h"
+#include "simple_vector_view.h"
+
+// Вектор записей, хранящий каждое поле в отдельном массиве (structure of arrays).
+// Проход по одному полю читает только его столбец, не затягивая в кэш остальные поля,
+// а столбцы доступны как непрерывные SimpleVectorView для векторизуемых циклов.
+// Строка доступна как кортеж ссылок на поля: v[i], итераторы и At возвращают std::tuple<Types&...>.
+// Все столбцы имеют общие размер и вместимость и перераспределяются вместе
+template <typename... Types>
+class SoaVector {
+    static_assert(sizeof...(Types) != 0, "SoaVector needs at least one column");
+
+    static constexpr size_t kColumns = sizeof...(Types);
+
+    // Суммарный размер полей одной строки
+    static constexpr size_t kRowSize = (sizeof(Types) + ...);
+
+    // Итератор произвольного доступа, хранящий вектор и индекс строки.
+    // Разыменование возвращает кортеж ссылок Reference по значению
+    template <typename Owner, typename Reference>
+    class BasicIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::tuple<Types...>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Reference;
+
+        BasicIterator() = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept : owner_(owner), index_(index) {
+        }
+
+        // Неконстантный итератор преобразуется в константный
+        template <typename OtherOwner, typename OtherReference,
+            typename = std::enable_if_t<std::is_convertible_v<OtherOwner*, Owner*>>>
+        BasicIterator(const BasicIterator<OtherOwner, OtherReference>& other) noexcept
+            : owner_(other.owner_), index_(other.index_) {
+        }
+
+        // Возвращает индекс строки, на которую указывает итератор
+        size_t GetIndex() const noexcept {
+            return index_;
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return (*owner_)[index_ + offset];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy(*this);
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy(*this);
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        template <typename, typename>
+        friend class BasicIterator;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    // Тип поля с номером Column
+    template <size_t Column>
+    using ColumnType = std::tuple_element_t<Column, std::tuple<Types...>>;
+
+    using Reference = std::tuple<Types&...>;
+    using ConstReference = std::tuple<const Types&...>;
+    using Iterator = BasicIterator<SoaVector, Reference>;
+    using ConstIterator = BasicIterator<const SoaVector, ConstReference>;
+
+    SoaVector() noexcept = default;
+
+    // Создает вектор из size строк, поля которых инициализированы значением по умолчанию
+    explicit SoaVector(size_t size) {
+        Resize(size);
+    }
+
+    SoaVector(const SoaVector& other) {
+        Reserve(other.size_);
+        CopyColumns_<0>(other);
+        size_ = other.size_;
+    }
+
+    SoaVector(SoaVector&& other) noexcept
+        : columns_(std::move(other.columns_))
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0)) {
+    }
+
+    SoaVector& operator=(const SoaVector& rhs) {
+        if (this != &rhs) {
+            SoaVector copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SoaVector& operator=(SoaVector&& rhs) noexcept {
+        if (this != &rhs) {
+            SoaVector moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    ~SoaVector() {
+        Clear();
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SoaVector& other) noexcept {
+        std::apply([&other](auto&... columns) {
+            std::apply([&columns...](auto&... other_columns) {
+                (columns.swap(other_columns), ...);
+            }, other.columns_);
+        }, columns_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    // Добавляет строку в конец вектора. При нехватке места все столбцы перераспределяются вместе
+    void PushBack(Types... values) {
+        if (size_ == capacity_) {
+            Reallocate_(DoublingGrowth::NextCapacity(capacity_, size_ + 1, kRowSize));
+        }
+        std::tuple<Types&...> sources(values...);
+        ConstructRow_<0>(size_, sources);
+        ++size_;
+    }
+
+    // Удаляет последнюю строку вектора
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        std::apply([this](auto&... columns) {
+            (std::destroy_at(columns.Get() + size_), ...);
+        }, columns_);
+    }
+
+    // Удаляет строку в указанной позиции. Возвращает итератор на строку, следовавшую за удаленной
+    Iterator Erase(ConstIterator pos) {
+        assert(pos.GetIndex() < size_);
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет строки в диапазоне [first, last), сдвигая хвост каждого столбца один раз.
+    // Возвращает итератор на строку, следовавшую за удаленными
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t first_index = first.GetIndex();
+        const size_t last_index = last.GetIndex();
+        assert(first_index <= last_index && last_index <= size_);
+        if (first_index != last_index) {
+            std::apply([this, first_index, last_index](auto&... columns) {
+                (EraseColumn_(columns.Get(), first_index, last_index), ...);
+            }, columns_);
+            size_ -= last_index - first_index;
+        }
+        return Iterator(this, first_index);
+    }
+
+    // Разрушает все строки, не изменяя вместимость
+    void Clear() noexcept {
+        std::apply([this](auto&... columns) {
+            (std::destroy(columns.Get(), columns.Get() + size_), ...);
+        }, columns_);
+        size_ = 0;
+    }
+
+    // Изменяет размер вектора. Новые строки получают значения по умолчанию
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            std::apply([new_size, this](auto&... columns) {
+                (std::destroy(columns.Get() + new_size, columns.Get() + size_), ...);
+            }, columns_);
+            size_ = new_size;
+            return;
+        }
+
+        if (new_size > capacity_) {
+            Reallocate_(DoublingGrowth::NextCapacity(capacity_, new_size, kRowSize));
+        }
+        ValueConstructColumns_<0>(size_, new_size);
+        size_ = new_size;
+    }
+
+    // Изменяет вместимость всех столбцов
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            Reallocate_(new_capacity);
+        }
+    }
+
+    // Возвращает количество строк
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость вектора
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает непрерывный столбец с номером Column
+    template <size_t Column>
+    SimpleVectorView<ColumnType<Column>> GetColumn() noexcept {
+        return SimpleVectorView<ColumnType<Column>>(std::get<Column>(columns_).Get(), size_);
+    }
+
+    template <size_t Column>
+    SimpleVectorView<const ColumnType<Column>> GetColumn() const noexcept {
+        return SimpleVectorView<const ColumnType<Column>>(std::get<Column>(columns_).Get(), size_);
+    }
+
+    // Возвращает кортеж ссылок на поля строки с индексом index
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return std::apply([index](auto&... columns) {
+            return Reference(columns.Get()[index]...);
+        }, columns_);
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return std::apply([index](const auto&... columns) {
+            return ConstReference(columns.Get()[index]...);
+        }, columns_);
+    }
+
+    // Возвращает кортеж ссылок на поля строки с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Reference At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("index is out of range");
+        }
+        return (*this)[index];
+    }
+
+    ConstReference At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("index is out of range");
+        }
+        return (*this)[index];
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    // Столбцы: память под capacity_ элементов каждого поля, живыми являются первые size_
+    std::tuple<ArrayPtr<Types>...> columns_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+
+    // Переносит все столбцы в массивы вместимостью new_capacity.
+    // Тривиально перемещаемые столбцы расширяются через reallocate аллокатора
+    void Reallocate_(size_t new_capacity) {
+        std::apply([this, new_capacity](auto&... columns) {
+            (ReallocateColumn_(columns, new_capacity), ...);
+        }, columns_);
+        capacity_ = new_capacity;
+    }
+
+    template <typename Type>
+    void ReallocateColumn_(ArrayPtr<Type>& column, size_t new_capacity) {
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            column.Reallocate(new_capacity, size_);
+        }
+        else {
+            ArrayPtr<Type> new_column(new_capacity);
+            UninitializedRelocate(column.Get(), column.Get() + size_, new_column.Get());
+            column = std::move(new_column);
+        }
+    }
+
+    // Удаляет элементы [first, last) столбца, сдвигая его хвост
+    template <typename Type>
+    void EraseColumn_(Type* column, size_t first, size_t last) {
+        if constexpr (IsTriviallyRelocatableV<Type>) {
+            std::destroy(column + first, column + last);
+            RelocateOverlapping(column + last, column + size_, column + first);
+        }
+        else {
+            Type* const new_end = std::move(column + last, column + size_, column + first);
+            std::destroy(new_end, column + size_);
+        }
+    }
+
+    // Создает поля строки index из values, начиная со столбца Column.
+    // Если создание поля выбрасывает исключение, уже созданные поля строки разрушаются
+    template <size_t Column>
+    void ConstructRow_(size_t index, std::tuple<Types&...>& values) {
+        if constexpr (Column < kColumns) {
+            ColumnType<Column>* item = std::get<Column>(columns_).Get() + index;
+            new (item) ColumnType<Column>(std::move(std::get<Column>(values)));
+            try {
+                ConstructRow_<Column + 1>(index, values);
+            }
+            catch (...) {
+                std::destroy_at(item);
+                throw;
+            }
+        }
+    }
+
+    // Создает значения по умолчанию в строках [first, last) столбцов, начиная с Column
+    template <size_t Column>
+    void ValueConstructColumns_(size_t first, size_t last) {
+        if constexpr (Column < kColumns) {
+            ColumnType<Column>* column = std::get<Column>(columns_).Get();
+            std::uninitialized_value_construct(column + first, column + last);
+            try {
+                ValueConstructColumns_<Column + 1>(first, last);
+            }
+            catch (...) {
+                std::destroy(column + first, column + last);
+                throw;
+            }
+        }
+    }
+
+    // Копирует строки other в пустые столбцы, начиная с Column
+    template <size_t Column>
+    void CopyColumns_(const SoaVector& other) {
+        if constexpr (Column < kColumns) {
+            const ColumnType<Column>* source = std::get<Column>(other.columns_).Get();
+            ColumnType<Column>* column = std::get<Column>(columns_).Get();
+            std::uninitialized_copy(source, source + other.size_, column);
+            try {
+                CopyColumns_<Column + 1>(other);
+            }
+            catch (...) {
+                std::destroy(column, column + other.size_);
+                throw;
+            }
+        }
+    }
+
+    template <size_t... Columns>
+    bool ColumnsEqual_(const SoaVector& other, std::index_sequence<Columns...>) const {
+        return (detail::RangesEqual<ColumnType<Columns>>(std::get<Columns>(columns_).Get(),
+            std::get<Columns>(other.columns_).Get(), size_) && ...);
+    }
+
+    template <typename... Other>
+    friend bool operator==(const SoaVector<Other...>& lhs, const SoaVector<Other...>& rhs);
+};
+
+template <typename... Types>
+inline bool operator==(const SoaVector<Types...>& lhs, const SoaVector<Types...>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && lhs.ColumnsEqual_(rhs, std::index_sequence_for<Types...>());
+}
+
+template <typename... Types>
+inline bool operator!=(const SoaVector<Types...>& lhs, const SoaVector<Types...>& rhs) {
+    return !(lhs == rhs);
+}
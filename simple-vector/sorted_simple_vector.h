@@ -0,0 +1,522 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+
+    // Возвращает указатель на первый элемент [first, first + count), не меньший key.
+    // Выбор половины не содержит условных переходов и компилируется в условную пересылку,
+    // поэтому поиск не страдает от ошибок предсказания ветвлений
+    template <typename Pointer, typename Key, typename Compare>
+    Pointer BranchlessLowerBound(Pointer first, size_t count, const Key& key, const Compare& comp) {
+        if (count == 0) {
+            return first;
+        }
+        while (count > 1) {
+            const size_t half = count / 2;
+            first = comp(first[half - 1], key) ? first + half : first;
+            count -= half;
+        }
+        return first + (comp(*first, key) ? 1 : 0);
+    }
+
+    // Возвращает указатель на первый элемент [first, first + count), больший key
+    template <typename Pointer, typename Key, typename Compare>
+    Pointer BranchlessUpperBound(Pointer first, size_t count, const Key& key, const Compare& comp) {
+        if (count == 0) {
+            return first;
+        }
+        while (count > 1) {
+            const size_t half = count / 2;
+            first = comp(key, first[half - 1]) ? first : first + half;
+            count -= half;
+        }
+        return first + (comp(key, *first) ? 0 : 1);
+    }
+
+    // Итератор, обходящий упорядоченную часть и упорядоченный буфер SortedStorage как одну последовательность:
+    // части сливаются на лету, без изменения контейнера. Из равных элементов первым идет элемент упорядоченной части
+    template <typename Pointer, typename Compare>
+    class SortedIterator {
+        template <typename, typename>
+        friend class SortedIterator;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_cv_t<std::remove_pointer_t<Pointer>>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Pointer;
+        using reference = std::remove_pointer_t<Pointer>&;
+
+        SortedIterator() noexcept = default;
+
+        SortedIterator(Pointer sorted, Pointer sorted_end, Pointer staged, Pointer staged_end, const Compare* comp)
+            : sorted_(sorted), sorted_end_(sorted_end), staged_(staged), staged_end_(staged_end), comp_(comp) {
+            Select_();
+        }
+
+        // Итератор по изменяемым элементам приводится к итератору по константным
+        template <typename Other, typename = std::enable_if_t<
+            !std::is_same_v<Other, Pointer> && std::is_convertible_v<Other, Pointer>>>
+        SortedIterator(const SortedIterator<Other, Compare>& other) noexcept
+            : sorted_(other.sorted_), sorted_end_(other.sorted_end_), staged_(other.staged_),
+            staged_end_(other.staged_end_), comp_(other.comp_), from_staged_(other.from_staged_) {
+        }
+
+        reference operator*() const noexcept {
+            return from_staged_ ? *staged_ : *sorted_;
+        }
+
+        pointer operator->() const noexcept {
+            return from_staged_ ? staged_ : sorted_;
+        }
+
+        SortedIterator& operator++() {
+            if (from_staged_) {
+                ++staged_;
+            }
+            else {
+                ++sorted_;
+            }
+            Select_();
+            return *this;
+        }
+
+        SortedIterator operator++(int) {
+            SortedIterator copy(*this);
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const SortedIterator& lhs, const SortedIterator& rhs) noexcept {
+            return lhs.sorted_ == rhs.sorted_ && lhs.staged_ == rhs.staged_;
+        }
+
+        friend bool operator!=(const SortedIterator& lhs, const SortedIterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+    private:
+        Pointer sorted_ = nullptr;
+        Pointer sorted_end_ = nullptr;
+        Pointer staged_ = nullptr;
+        Pointer staged_end_ = nullptr;
+        const Compare* comp_ = nullptr;
+        // Указывает ли итератор на элемент буфера
+        bool from_staged_ = false;
+
+        void Select_() {
+            from_staged_ = staged_ != staged_end_ && (sorted_ == sorted_end_ || (*comp_)(*staged_, *sorted_));
+        }
+    };
+
+    // Упорядоченный массив с буфером вставок. Новые элементы вставляются в небольшой упорядоченный буфер,
+    // а при его заполнении буфер сливается с упорядоченной частью за один линейный проход с конца,
+    // без промежуточного массива: каждый элемент перемещается не более одного раза вместо сдвига хвоста
+    // при каждой вставке. Поиск выполняется двоичным поиском по обеим частям, а обход сливает их на лету.
+    // Константные методы не изменяют контейнер, поэтому их можно вызывать из нескольких потоков одновременно
+    template <typename Type, typename Compare, size_t StagingCapacity>
+    class SortedStorage {
+        static_assert(StagingCapacity != 0, "StagingCapacity must be positive");
+        static_assert(std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>,
+            "sorted containers require nothrow movable elements");
+
+    public:
+        using Iterator = SortedIterator<Type*, Compare>;
+        using ConstIterator = SortedIterator<const Type*, Compare>;
+
+        SortedStorage() = default;
+
+        explicit SortedStorage(const Compare& comp) : comp_(comp) {
+        }
+
+        size_t GetSize() const noexcept {
+            return sorted_.GetSize() + staging_.GetSize();
+        }
+
+        size_t GetStagedSize() const noexcept {
+            return staging_.GetSize();
+        }
+
+        const Compare& GetCompare() const noexcept {
+            return comp_;
+        }
+
+        void Clear() noexcept {
+            sorted_.Clear();
+            staging_.Clear();
+        }
+
+        void Reserve(size_t capacity) {
+            sorted_.Reserve(capacity);
+        }
+
+        // Заменяет содержимое элементами items, упорядочивая их. При unique из равных элементов
+        // остается первый
+        void Assign(SimpleVector<Type>&& items, bool unique) {
+            std::stable_sort(items.begin(), items.end(), comp_);
+            if (unique) {
+                const auto new_end = std::unique(items.begin(), items.end(), [this](const Type& lhs, const Type& rhs) {
+                    return !comp_(lhs, rhs);
+                });
+                items.Erase(new_end, items.end());
+            }
+            sorted_ = std::move(items);
+            staging_.Clear();
+        }
+
+        // Возвращает указатель на элемент, равный key, или nullptr
+        template <typename Key>
+        const Type* Find(const Key& key) const {
+            if (const Type* found = FindIn_(sorted_, key)) {
+                return found;
+            }
+            return FindIn_(staging_, key);
+        }
+
+        template <typename Key>
+        Type* Find(const Key& key) {
+            return const_cast<Type*>(std::as_const(*this).Find(key));
+        }
+
+        // Возвращает число элементов, равных key
+        template <typename Key>
+        size_t Count(const Key& key) const {
+            return CountIn_(sorted_, key) + CountIn_(staging_, key);
+        }
+
+        // Возвращает элемент с индексом index в порядке возрастания
+        const Type& Get(size_t index) const {
+            // Каждый элемент буфера, стоящий при слиянии раньше позиции index, сдвигает ее в упорядоченной части
+            size_t staged = 0;
+            for (; staged < staging_.GetSize(); ++staged) {
+                const Type* const upper = BranchlessUpperBound(sorted_.begin(), sorted_.GetSize(), staging_[staged], comp_);
+                const size_t position = static_cast<size_t>(upper - sorted_.begin()) + staged;
+                if (position == index) {
+                    return staging_[staged];
+                }
+                if (position > index) {
+                    break;
+                }
+            }
+            return sorted_[index - staged];
+        }
+
+        // Вставляет value в буфер, предварительно слив заполненный буфер.
+        // Возвращает ссылку на добавленный элемент, действительную до следующего изменения
+        Type& Stage(Type&& value) {
+            if (staging_.GetSize() == StagingCapacity) {
+                Merge();
+            }
+            staging_.Reserve(StagingCapacity);
+            // Равные элементы сохраняют порядок вставки
+            const Type* const position = BranchlessUpperBound(staging_.begin(), staging_.GetSize(), value, comp_);
+            return *staging_.Insert(position, std::move(value));
+        }
+
+        // Добавляет элементы [first, last) за одно слияние. При unique добавляются только элементы,
+        // которых еще нет, а из равных новых элементов остается первый.
+        // Новые элементы упорядочиваются во временном массиве, поэтому при исключении контейнер не изменяется
+        template <typename InputIterator>
+        void StageRange(InputIterator first, InputIterator last, bool unique) {
+            SimpleVector<Type> items(first, last);
+            std::stable_sort(items.begin(), items.end(), comp_);
+            if (unique) {
+                Type* out = items.begin();
+                for (Type* item = items.begin(); item != items.end(); ++item) {
+                    if ((out == items.begin() || comp_(*(out - 1), *item)) && Find(*item) == nullptr) {
+                        if (out != item) {
+                            *out = std::move(*item);
+                        }
+                        ++out;
+                    }
+                }
+                items.Erase(out, items.end());
+            }
+            Merge();
+            MergeFrom_(items);
+        }
+
+        // Удаляет все элементы, равные key. Возвращает число удаленных элементов
+        template <typename Key>
+        size_t EraseAll(const Key& key) {
+            return EraseAllIn_(sorted_, key) + EraseAllIn_(staging_, key);
+        }
+
+        // Удаляет элемент, найденный Find
+        void Erase(Type* item) {
+            if (item >= staging_.begin() && item < staging_.end()) {
+                staging_.Erase(item);
+            }
+            else {
+                sorted_.Erase(item);
+            }
+        }
+
+        // Сливает буфер с упорядоченной частью. Равные элементы сохраняют порядок вставки
+        void Merge() {
+            MergeFrom_(staging_);
+        }
+
+        // Возвращает итератор на элемент item, найденный Find
+        Iterator IteratorAt(Type* item) {
+            const auto [sorted, staged] = Position_(item);
+            return Iterator(sorted_.begin() + sorted, sorted_.end(), staging_.begin() + staged, staging_.end(), &comp_);
+        }
+
+        ConstIterator IteratorAt(const Type* item) const {
+            const auto [sorted, staged] = Position_(item);
+            return ConstIterator(sorted_.begin() + sorted, sorted_.end(), staging_.begin() + staged, staging_.end(), &comp_);
+        }
+
+        Iterator begin() {
+            return Iterator(sorted_.begin(), sorted_.end(), staging_.begin(), staging_.end(), &comp_);
+        }
+
+        Iterator end() {
+            return Iterator(sorted_.end(), sorted_.end(), staging_.end(), staging_.end(), &comp_);
+        }
+
+        ConstIterator begin() const {
+            return ConstIterator(sorted_.begin(), sorted_.end(), staging_.begin(), staging_.end(), &comp_);
+        }
+
+        ConstIterator end() const {
+            return ConstIterator(sorted_.end(), sorted_.end(), staging_.end(), staging_.end(), &comp_);
+        }
+
+    private:
+        SimpleVector<Type> sorted_;
+        SimpleVector<Type> staging_;
+        Compare comp_{};
+
+        // Возвращает позиции, на которых обход стоит в упорядоченной части и в буфере, дойдя до элемента item
+        std::pair<size_t, size_t> Position_(const Type* item) const {
+            if (item >= staging_.begin() && item < staging_.end()) {
+                const Type* const sorted = BranchlessUpperBound(sorted_.begin(), sorted_.GetSize(), *item, comp_);
+                return { static_cast<size_t>(sorted - sorted_.begin()), static_cast<size_t>(item - staging_.begin()) };
+            }
+            const Type* const staged = BranchlessLowerBound(staging_.begin(), staging_.GetSize(), *item, comp_);
+            return { static_cast<size_t>(item - sorted_.begin()), static_cast<size_t>(staged - staging_.begin()) };
+        }
+
+        template <typename Key>
+        const Type* FindIn_(const SimpleVector<Type>& items, const Key& key) const {
+            const Type* const found = BranchlessLowerBound(items.begin(), items.GetSize(), key, comp_);
+            return found != items.end() && !comp_(key, *found) ? found : nullptr;
+        }
+
+        template <typename Key>
+        size_t CountIn_(const SimpleVector<Type>& items, const Key& key) const {
+            const Type* const lower = BranchlessLowerBound(items.begin(), items.GetSize(), key, comp_);
+            return BranchlessUpperBound(lower, items.end() - lower, key, comp_) - lower;
+        }
+
+        template <typename Key>
+        size_t EraseAllIn_(SimpleVector<Type>& items, const Key& key) {
+            Type* const lower = BranchlessLowerBound(items.begin(), items.GetSize(), key, comp_);
+            Type* const upper = BranchlessUpperBound(lower, items.end() - lower, key, comp_);
+            items.Erase(lower, upper);
+            return upper - lower;
+        }
+
+        // Сливает упорядоченные элементы staged с упорядоченной частью и очищает staged.
+        // Равные элементы staged идут после прежних. Сначала для каждого элемента staged вычисляется
+        // место вставки и резервируется память, и только затем элементы перемещаются, не выбрасывая исключений,
+        // поэтому исключение из comp_ или при выделении памяти оставляет контейнер неизменным
+        void MergeFrom_(SimpleVector<Type>& staged) {
+            if (staged.IsEmpty()) {
+                return;
+            }
+            SimpleVector<size_t> positions;
+            positions.ResizeForOverwrite(staged.GetSize());
+            const Type* lower = sorted_.begin();
+            for (size_t i = 0; i < staged.GetSize(); ++i) {
+                lower = BranchlessUpperBound(lower, sorted_.end() - lower, staged[i], comp_);
+                positions[i] = lower - sorted_.begin();
+            }
+
+            const size_t size = sorted_.GetSize();
+            const size_t count = staged.GetSize();
+            sorted_.Reserve(size + count);
+
+            // Последние count элементов результата попадают в новые ячейки за концом упорядоченной части.
+            // Определяем, сколько элементов каждой части останется перед ними
+            size_t left = size;
+            size_t right = count;
+            for (size_t i = 0; i < count; ++i) {
+                if (right != 0 && left <= positions[right - 1]) {
+                    --right;
+                }
+                else {
+                    --left;
+                }
+            }
+            // Создаем новые ячейки перемещением по возрастанию, поэтому элементам не нужен конструктор по умолчанию
+            for (size_t from_sorted = left, from_staged = right; from_sorted != size || from_staged != count;) {
+                if (from_staged != count && (from_sorted == size || positions[from_staged] <= from_sorted)) {
+                    sorted_.EmplaceBack(std::move(staged[from_staged++]));
+                }
+                else {
+                    sorted_.EmplaceBack(std::move(sorted_[from_sorted++]));
+                }
+            }
+
+            Type* const items = sorted_.begin();
+            // Остальное сливаем с конца в прежние ячейки. Когда буфер исчерпан, оставшиеся элементы
+            // упорядоченной части уже на своих местах
+            for (size_t out = left + right; right != 0; --right) {
+                while (left > positions[right - 1]) {
+                    items[--out] = std::move(items[--left]);
+                }
+                items[--out] = std::move(staged[right - 1]);
+            }
+            staged.Clear();
+        }
+    };
+
+}
+
+// Упорядоченный вектор с повторяющимися элементами на основе SimpleVector.
+// Вставки накапливаются в упорядоченном буфере на StagingCapacity элементов и сливаются
+// с упорядоченной частью за один линейный проход при его заполнении, поэтому серия из StagingCapacity
+// вставок стоит одного сдвига массива. Поиск выполняется двоичным поиском без ветвлений по обеим частям.
+// Ключи поиска могут иметь другой тип, если Compare умеет сравнивать его с Type.
+// Константные методы, включая обход, не сливают буфер, поэтому их можно вызывать из нескольких потоков
+template <typename Type, typename Compare = std::less<Type>, size_t StagingCapacity = 64>
+class SortedSimpleVector {
+    using Storage = detail::SortedStorage<Type, Compare, StagingCapacity>;
+
+public:
+    using Iterator = typename Storage::ConstIterator;
+    using ConstIterator = typename Storage::ConstIterator;
+
+    SortedSimpleVector() = default;
+
+    explicit SortedSimpleVector(const Compare& comp) : storage_(comp) {
+    }
+
+    // Создает вектор из элементов init, упорядочивая их
+    SortedSimpleVector(std::initializer_list<Type> init, const Compare& comp = Compare()) : storage_(comp) {
+        storage_.Assign(SimpleVector<Type>(init), false);
+    }
+
+    size_t GetSize() const noexcept {
+        return storage_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    void Clear() noexcept {
+        storage_.Clear();
+    }
+
+    // Резервирует память под capacity упорядоченных элементов
+    void Reserve(size_t capacity) {
+        storage_.Reserve(capacity);
+    }
+
+    // Добавляет элемент. Ссылки и итераторы на элементы становятся недействительными
+    void Insert(const Type& value) {
+        storage_.Stage(Type(value));
+    }
+
+    void Insert(Type&& value) {
+        storage_.Stage(std::move(value));
+    }
+
+    // Добавляет элементы [first, last), сливая их с упорядоченной частью за один проход
+    template <typename InputIterator, typename = detail::RequireInputIterator<InputIterator>>
+    void Insert(InputIterator first, InputIterator last) {
+        storage_.StageRange(first, last, false);
+    }
+
+    // Сообщает, есть ли в векторе элемент, равный key
+    template <typename Key>
+    bool Contains(const Key& key) const {
+        return storage_.Find(key) != nullptr;
+    }
+
+    // Возвращает указатель на элемент, равный key, или nullptr.
+    // Указатель действителен до следующего изменения вектора
+    template <typename Key>
+    const Type* Find(const Key& key) const {
+        return storage_.Find(key);
+    }
+
+    // Возвращает количество элементов, равных key
+    template <typename Key>
+    size_t Count(const Key& key) const {
+        return storage_.Count(key);
+    }
+
+    // Удаляет все элементы, равные key. Возвращает количество удаленных элементов
+    template <typename Key>
+    size_t Erase(const Key& key) {
+        return storage_.EraseAll(key);
+    }
+
+    // Сливает накопленные вставки с упорядоченной частью
+    void Flush() {
+        storage_.Merge();
+    }
+
+    // Возвращает ссылку на элемент с индексом index в порядке возрастания.
+    // Пока буфер не слит, поиск элемента стоит O(StagingCapacity * log(size))
+    const Type& operator[](size_t index) const {
+        assert(index < GetSize());
+        return storage_.Get(index);
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("index is out of range");
+        }
+        return (*this)[index];
+    }
+
+    ConstIterator begin() const {
+        return storage_.begin();
+    }
+
+    ConstIterator end() const {
+        return storage_.end();
+    }
+
+    ConstIterator cbegin() const {
+        return begin();
+    }
+
+    ConstIterator cend() const {
+        return end();
+    }
+
+private:
+    Storage storage_;
+};
+
+template <typename Type, typename Compare, size_t StagingCapacity>
+inline bool operator==(const SortedSimpleVector<Type, Compare, StagingCapacity>& lhs,
+    const SortedSimpleVector<Type, Compare, StagingCapacity>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, typename Compare, size_t StagingCapacity>
+inline bool operator!=(const SortedSimpleVector<Type, Compare, StagingCapacity>& lhs,
+    const SortedSimpleVector<Type, Compare, StagingCapacity>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,32 @@
+#include <utility>
+
+#include "tests.h"
+
+// Определения вспомогательных типов из tests.h, общие для тестов и замеров производительности
+
+namespace tests {
+
+    namespace detail {
+
+        X::X() : X(5) {
+        }
+
+        X::X(size_t num) : x_(num) {
+        }
+
+        X::X(X&& other) noexcept {
+            x_ = std::exchange(other.x_, 0);
+        }
+
+        X& X::operator=(X&& other) noexcept {
+            x_ = std::exchange(other.x_, 0);
+            return *this;
+        }
+
+        size_t X::GetX() const {
+            return x_;
+        }
+
+    }
+
+}
@@ -1,7 +1,26 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <sstream>
+#include <memory_resource>
 #include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "tests.h"
 
@@ -9,379 +28,3098 @@ namespace tests {
 
     namespace detail {
 
-        X::X() : X(5) {
+        // Элемент, размер которого не делит классы размеров malloc
+        struct Record24 {
+            char bytes[24];
+        };
+
+        // Тип, по которому в тесте учета никакие другие векторы не создаются
+        struct Probe {
+            int value;
+        };
+
+        inline size_t sink_events = 0;
+
+        inline void CountSinkEvent(const VectorEventInfo& info) {
+            if (*info.type == typeid(Probe)) {
+                ++sink_events;
+            }
+        }
+
+        // Функция, принимающая представление вместо const SimpleVector&
+        int Sum(SimpleVectorView<const int> values) {
+            return std::accumulate(values.begin(), values.end(), 0);
+        }
+
+        // Тип без конструктора по умолчанию, подсчитывающий число живых объектов
+        class Counted {
+        public:
+            explicit Counted(int value) : value_(value) {
+                ++alive;
+            }
+
+            Counted(const Counted& other) : value_(other.value_) {
+                ++alive;
+            }
+
+            Counted& operator=(const Counted& other) = default;
+
+            ~Counted() {
+                --alive;
+            }
+
+            int GetValue() const {
+                return value_;
+            }
+
+            static inline int alive = 0;
+
+        private:
+            int value_;
+        };
+
+        // Тип, конструктор перемещения которого может выбросить исключение.
+        // Копирование выбрасывает исключение, когда исчерпан неотрицательный счетчик copies_left
+        class ThrowingMove {
+        public:
+            explicit ThrowingMove(int value) : value_(value) {
+                ++alive;
+            }
+
+            ThrowingMove(const ThrowingMove& other) : value_(other.value_) {
+                if (copies_left == 0) {
+                    throw std::runtime_error("copy failed");
+                }
+                if (copies_left > 0) {
+                    --copies_left;
+                }
+                ++alive;
+            }
+
+            ThrowingMove(ThrowingMove&& other) noexcept(false) : value_(other.value_) {
+                ++moves;
+                ++alive;
+            }
+
+            ThrowingMove& operator=(const ThrowingMove& other) = default;
+
+            ~ThrowingMove() {
+                --alive;
+            }
+
+            int GetValue() const {
+                return value_;
+            }
+
+            static inline int alive = 0;
+            static inline int moves = 0;
+            static inline int copies_left = -1;
+
+        private:
+            int value_;
+        };
+
+        // Проверяет, что элементы вектора равны values
+        template <typename Vector>
+        bool HasValues(const Vector& v, std::initializer_list<int> values) {
+            return v.GetSize() == values.size()
+                && std::equal(v.begin(), v.end(), values.begin(), [](const ThrowingMove& item, int value) {
+                    return item.GetValue() == value;
+                });
         }
 
-        X::X(size_t num) : x_(num) {
+        Relocatable::Relocatable(int value) : value_(std::make_unique<int>(value)) {
         }
 
-        X::X(X&& other) noexcept {
-            x_ = std::exchange(other.x_, 0);
+        Relocatable::Relocatable(Relocatable&& other) noexcept : value_(std::move(other.value_)) {
+            ++moves;
         }
 
-        X& X::operator=(X&& other) noexcept {
-            x_ = std::exchange(other.x_, 0);
+        Relocatable& Relocatable::operator=(Relocatable&& other) noexcept {
+            value_ = std::move(other.value_);
+            ++moves;
             return *this;
         }
 
-        size_t X::GetX() const {
-            return x_;
+        int Relocatable::GetValue() const {
+            return *value_;
         }
 
-        SimpleVector<int> GenerateVector(size_t size) {
-            SimpleVector<int> v(size);
+        template <template <typename> typename Vector>
+        Vector<int> GenerateVector(size_t size) {
+            Vector<int> v(size);
             std::iota(v.begin(), v.end(), 1);
             return v;
         }
 
+        // Буфер потока без позиционирования, отдающий байты строки по одному, как канал или сокет
+        class UnseekableBuffer : public std::streambuf {
+        public:
+            explicit UnseekableBuffer(std::string data) : data_(std::move(data)) {
+            }
+
+        private:
+            std::string data_;
+            size_t position_ = 0;
+            char current_ = 0;
+
+            int_type underflow() override {
+                if (position_ == data_.size()) {
+                    return traits_type::eof();
+                }
+                current_ = data_[position_++];
+                setg(&current_, &current_, &current_ + 1);
+                return traits_type::to_int_type(current_);
+            }
+        };
+
+        // Ресурс памяти, подсчитывающий выделения и еще не освобожденные байты
+        class CountingResource : public std::pmr::memory_resource {
+        public:
+            size_t GetAllocations() const {
+                return allocations_;
+            }
+
+            size_t GetBytesInUse() const {
+                return bytes_in_use_;
+            }
+
+        private:
+            // Счетчики атомарны, чтобы ресурс можно было использовать из нескольких потоков
+            std::atomic<size_t> allocations_{ 0 };
+            std::atomic<size_t> bytes_in_use_{ 0 };
+
+            void* do_allocate(size_t bytes, size_t alignment) override {
+                ++allocations_;
+                bytes_in_use_ += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+                bytes_in_use_ -= bytes;
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                return this == &other;
+            }
+        };
+
+        // Аллокатор с меткой, распространяющийся при копировании, перемещении и обмене
+        template <typename Type>
+        struct TaggedAllocator {
+            using value_type = Type;
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+            using is_always_equal = std::false_type;
+
+            explicit TaggedAllocator(int tag = 0) noexcept : tag(tag) {
+            }
+
+            template <typename Other>
+            TaggedAllocator(const TaggedAllocator<Other>& other) noexcept : tag(other.tag) {
+            }
+
+            Type* allocate(size_t n) {
+                return std::allocator<Type>().allocate(n);
+            }
+
+            void deallocate(Type* p, size_t n) noexcept {
+                std::allocator<Type>().deallocate(p, n);
+            }
+
+            int tag;
+        };
+
+        template <typename Type, typename Other>
+        bool operator==(const TaggedAllocator<Type>& lhs, const TaggedAllocator<Other>& rhs) noexcept {
+            return lhs.tag == rhs.tag;
+        }
+
+        template <typename Type, typename Other>
+        bool operator!=(const TaggedAllocator<Type>& lhs, const TaggedAllocator<Other>& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+        // Вектор со встроенным буфером, на котором запускаются общие тесты
+        template <typename Type>
+        using SmallVector = SmallSimpleVector<Type, 4>;
+
+        // Вместимость встроенного буфера вектора: ненулевая только у SmallSimpleVector
+        template <typename Vector, typename = void>
+        struct InlineCapacity : std::integral_constant<size_t, 0> {
+        };
+
+        template <typename Vector>
+        struct InlineCapacity<Vector, std::void_t<decltype(Vector::kInlineCapacity)>>
+            : std::integral_constant<size_t, Vector::kInlineCapacity> {
+        };
+
+        // Возвращает вместимость только что созданного вектора из size элементов
+        template <typename Vector>
+        size_t ExpectedCapacity(size_t size) {
+            return std::max(size, InlineCapacity<Vector>::value);
+        }
+
+        // Запускает тест, сделав CountingResource ресурсом памяти по умолчанию,
+        // и проверяет, что тест вернул ресурсу всю выделенную память
+        void RunWithResource(void (*test)()) {
+            CountingResource resource;
+            std::pmr::memory_resource* const old_resource = std::pmr::set_default_resource(&resource);
+            test();
+            std::pmr::set_default_resource(old_resource);
+            assert(resource.GetBytesInUse() == 0);
+        }
+
+        template <template <typename> typename Vector>
+        void DefaultConstructor() {
+            Vector<int> v;
+            assert(v.GetSize() == 0u);
+            assert(v.IsEmpty());
+            assert(v.GetCapacity() == ExpectedCapacity<Vector<int>>(0u));
+        }
+
+        template <template <typename> typename Vector>
+        void SizeConstructor() {
+            Vector<int> v(5);
+            assert(v.GetSize() == 5u);
+            assert(v.GetCapacity() == ExpectedCapacity<Vector<int>>(5u));
+            assert(!v.IsEmpty());
+            for (size_t i = 0; i < v.GetSize(); ++i) {
+                assert(v[i] == 0);
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void SizeValueConstructor() {
+            Vector<int> v(3, 42);
+            assert(v.GetSize() == 3);
+            assert(v.GetCapacity() == ExpectedCapacity<Vector<int>>(3));
+            for (size_t i = 0; i < v.GetSize(); ++i) {
+                assert(v[i] == 42);
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void InitializerListConstructor() {
+            Vector<int> v{ 1, 2, 3 };
+            assert(v.GetSize() == 3);
+            assert(v.GetCapacity() == ExpectedCapacity<Vector<int>>(3));
+            assert(v[2] == 3);
+        }
+
+        template <template <typename> typename Vector>
+        void At() {
+            Vector<int> v(3);
+            assert(&v.At(2) == &v[2]);
+            try {
+                v.At(3);
+                assert(false); 
+            }
+            catch (const std::out_of_range&) {
+            }
+            catch (...) {
+                assert(false); 
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void Clear() {
+            Vector<int> v(10);
+            const size_t old_capacity = v.GetCapacity();
+            v.Clear();
+            assert(v.GetSize() == 0);
+            assert(v.GetCapacity() == old_capacity);
+        }
+
+        template <template <typename> typename Vector>
+        void Resize() {
+            {
+                Vector<int> v(3);
+                v[2] = 17;
+                v.Resize(7);
+                assert(v.GetSize() == 7);
+                assert(v.GetCapacity() >= v.GetSize());
+                assert(v[2] == 17);
+                assert(v[3] == 0);
+            }
+            {
+                Vector<int> v(3);
+                v[0] = 42;
+                v[1] = 55;
+                const size_t old_capacity = v.GetCapacity();
+                v.Resize(2);
+                assert(v.GetSize() == 2);
+                assert(v.GetCapacity() == old_capacity);
+                assert(v[0] == 42);
+                assert(v[1] == 55);
+            }
+            {
+                const size_t old_size = 3;
+                Vector<int> v(3);
+                v.Resize(old_size + 5);
+                v[3] = 42;
+                v.Resize(old_size);
+                v.Resize(old_size + 2);
+                assert(v[3] == 0);
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void Reserve() {
+            {
+                Vector<int> v{ 1, 2, 3 };
+                v.Reserve(10);
+                assert(v.GetCapacity() == 10);
+                assert((v == Vector<int>{1, 2, 3}));
+
+                // Уменьшение вместимости игнорируется
+                v.Reserve(1);
+                assert(v.GetCapacity() == 10);
+            }
+            {
+                // Резервирование памяти не создает элементов
+                Vector<detail::Counted> v;
+                v.Reserve(100);
+                assert(detail::Counted::alive == 0);
+                v.PushBack(detail::Counted(1));
+                assert(detail::Counted::alive == 1);
+            }
+            assert(detail::Counted::alive == 0);
+        }
+
+        template <template <typename> typename Vector>
+        void NonDefaultConstructible() {
+            {
+                Vector<detail::Counted> v(2, detail::Counted(7));
+                assert(detail::Counted::alive == 2);
+                for (int i = 0; i < 10; ++i) {
+                    v.PushBack(detail::Counted(i));
+                }
+                assert(detail::Counted::alive == 12);
+
+                v.Insert(v.begin() + 1, detail::Counted(42));
+                assert(v[1].GetValue() == 42);
+                assert(detail::Counted::alive == 13);
+
+                v.Erase(v.begin());
+                v.PopBack();
+                assert(v.GetSize() == 11);
+                assert(detail::Counted::alive == 11);
+
+                Vector<detail::Counted> copy(v);
+                assert(detail::Counted::alive == 22);
+                v.Clear();
+                assert(detail::Counted::alive == 11);
+            }
+            assert(detail::Counted::alive == 0);
+        }
+
+        template <template <typename> typename Vector>
+        void TriviallyRelocatable() {
+            static_assert(IsTriviallyRelocatableV<int>);
+            static_assert(IsTriviallyRelocatableV<detail::Relocatable>);
+            static_assert(!IsTriviallyRelocatableV<detail::X>);
+            {
+                // При росте вектора элементы переносятся побайтово, без вызова перемещающих операций
+                const int size = 100;
+                Vector<detail::Relocatable> v;
+                detail::Relocatable::moves = 0;
+                for (int i = 0; i < size; ++i) {
+                    v.PushBack(detail::Relocatable(i));
+                }
+                assert(detail::Relocatable::moves == size);
+
+                v.Reserve(1000);
+                v.Insert(v.begin(), detail::Relocatable(-1));
+                v.Erase(v.begin() + 1);
+                assert(detail::Relocatable::moves == size + 1);
+                assert(v[0].GetValue() == -1);
+                for (int i = 1; i < size; ++i) {
+                    assert(v[i].GetValue() == i);
+                }
+            }
+            {
+                // Вставка элемента самого вектора с перераспределением памяти
+                Vector<int> v{ 1, 2, 3, 4 };
+                v.Insert(v.begin(), v[3]);
+                assert((v == Vector<int>{4, 1, 2, 3, 4}));
+                v.Insert(v.begin() + 2, v[4]);
+                assert((v == Vector<int>{4, 1, 4, 2, 3, 4}));
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void Iterate() {
+            {
+                Vector<int> v;
+                assert(v.begin() == v.end());
+                if constexpr (InlineCapacity<Vector<int>>::value == 0) {
+                    assert(v.begin() == nullptr);
+                    assert(v.end() == nullptr);
+                }
+            }
+            {
+                Vector<int> v(10, 42);
+                assert(v.begin());
+                assert(*v.begin() == 42);
+                assert(v.end() == v.begin() + v.GetSize());
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void PushBack() {
+            {
+                Vector<int> v(1);
+                v.PushBack(42);
+                assert(v.GetSize() == 2);
+                assert(v.GetCapacity() >= v.GetSize());
+                assert(v[0] == 0);
+                assert(v[1] == 42);
+            }
+
+            // Если хватает места, PushBack не увеличивает Capacity
+            {    
+                Vector<int> v(2);
+                v.Resize(1);
+                const size_t old_capacity = v.GetCapacity();
+                v.PushBack(123);
+                assert(v.GetSize() == 2);
+                assert(v.GetCapacity() == old_capacity);
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void PopBack() {
+            Vector<int> v{ 0, 1, 2, 3 };
+            const size_t old_capacity = v.GetCapacity();
+            const auto old_begin = v.begin();
+            v.PopBack();
+            assert(v.GetCapacity() == old_capacity);
+            assert(v.begin() == old_begin);
+            assert((v == Vector<int>{0, 1, 2}));
+        }
+
+        template <template <typename> typename Vector>
+        void CopyConstructor() {
+            Vector<int> numbers{ 1, 2 };
+            auto numbers_copy(numbers);
+            assert(&numbers_copy[0] != &numbers[0]);
+            assert(numbers_copy.GetSize() == numbers.GetSize());
+            for (size_t i = 0; i < numbers.GetSize(); ++i) {
+                assert(numbers_copy[i] == numbers[i]);
+                assert(&numbers_copy[i] != &numbers[i]);
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void Compare() {
+            assert((Vector<int>{ 1, 2, 3 } == Vector<int>{ 1, 2, 3 }));
+            assert((Vector<int>{ 1, 2, 3 } != Vector<int>{ 1, 2, 2 }));
+
+            assert((Vector<int>{ 1, 2, 3 } < Vector<int>{ 1, 2, 3, 1 }));
+            assert((Vector<int>{ 1, 2, 3 } > Vector<int>{ 1, 2, 2, 1 }));
+
+            assert((Vector<int>{ 1, 2, 3 } >= Vector<int>{ 1, 2, 3 }));
+            assert((Vector<int>{ 1, 2, 4 } >= Vector<int>{ 1, 2, 3 }));
+            assert((Vector<int>{ 1, 2, 3 } <= Vector<int>{ 1, 2, 3 }));
+            assert((Vector<int>{ 1, 2, 3 } <= Vector<int>{ 1, 2, 4 }));
+
+            // Знаковые элементы сравниваются по значению, а не по байтам
+            assert((Vector<int>{ -1 } < Vector<int>{ 1 }));
+            assert((Vector<char>{ 'a', 'b' } < Vector<char>{ 'a', 'c' }));
+
+            // Семантика плавающих элементов совпадает с поэлементным сравнением: NaN не равен себе,
+            // а пара с NaN не решает лексикографическое сравнение
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            assert((Vector<double>{ 0.0, 1.0 } == Vector<double>{ -0.0, 1.0 }));
+            assert((Vector<double>{ nan } != Vector<double>{ nan }));
+            assert(!(Vector<double>{ nan, 1.0 } < Vector<double>{ 1.0, 1.0 }));
+            assert((Vector<double>{ nan, 1.0 } < Vector<double>{ 1.0, 2.0 }));
+            assert((Vector<float>{ 1.0f, 2.0f } > Vector<float>{ 1.0f, 1.5f, 3.0f }));
+
+            using namespace std::string_literals;
+            assert((Vector<std::string>{ "a"s, "b"s } < Vector<std::string>{ "a"s, "c"s }));
+        }
+
+        // Сравнивает результаты ядер всех доступных уровней с std::equal и std::lexicographical_compare
+        // на парах диапазонов, различающихся в одной позиции
+        template <typename Type>
+        void CheckCompareKernels(std::mt19937& generator) {
+            using ::detail::SimdLevel;
+            std::uniform_int_distribution<int> values(-3, 3);
+            const SimdLevel best = ::detail::DetectSimdLevel();
+            for (size_t size : { 0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 64, 100, 257 }) {
+                std::vector<Type> a(size);
+                for (Type& x : a) {
+                    x = static_cast<Type>(values(generator));
+                }
+                for (size_t pos = 0; pos <= size; ++pos) {
+                    std::vector<Type> b = a;
+                    if (pos < size) {
+                        b[pos] = static_cast<Type>(b[pos] + 1);
+                    }
+                    if constexpr (std::is_floating_point_v<Type>) {
+                        if (pos % 3 == 1 && pos < size) {
+                            a[pos - 1] = b[pos - 1] = std::numeric_limits<Type>::quiet_NaN();
+                        }
+                    }
+                    const bool equal = std::equal(a.begin(), a.end(), b.begin());
+                    const bool less = std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+                    const bool greater = std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end());
+                    const bool shorter_less = std::lexicographical_compare(a.begin(), a.begin() + pos, b.begin(), b.end());
+                    assert(::detail::RangesEqual(a.data(), b.data(), size) == equal);
+                    assert(::detail::RangesLess(a.data(), size, b.data(), size) == less);
+                    assert(::detail::RangesLess(b.data(), size, a.data(), size) == greater);
+                    assert(::detail::RangesLess(a.data(), pos, b.data(), size) == shorter_less);
+
+                    for (SimdLevel level : { SimdLevel::kScalar, SimdLevel::kSse2, SimdLevel::kAvx2 }) {
+                        if (level > best) {
+                            break;
+                        }
+                        const size_t expected = static_cast<size_t>(std::mismatch(a.begin(), a.end(), b.begin(),
+                            [](Type x, Type y) { return x == y; }).first - a.begin());
+                        const size_t expected_ordered = static_cast<size_t>(std::mismatch(a.begin(), a.end(), b.begin(),
+                            [](Type x, Type y) { return !(x < y || y < x); }).first - a.begin());
+                        assert((::detail::FindMismatch<false>(a.data(), b.data(), size, level) == expected));
+                        assert((::detail::FindMismatch<true>(a.data(), b.data(), size, level) == expected_ordered));
+                    }
+                }
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void Swap() {
+            Vector<int> v1{ 42, 666 };
+            Vector<int> v2;
+            v2.PushBack(0);
+            v2.PushBack(1);
+            v2.PushBack(2);
+            const int* const begin1 = &v1[0];
+            const int* const begin2 = &v2[0];
+
+            const size_t capacity1 = v1.GetCapacity();
+            const size_t capacity2 = v2.GetCapacity();
+
+            const size_t size1 = v1.GetSize();
+            const size_t size2 = v2.GetSize();
+
+            v1.swap(v2);
+            // Элементы встроенного буфера переносятся при обмене, поэтому их адреса меняются
+            if constexpr (InlineCapacity<Vector<int>>::value == 0) {
+                assert(&v2[0] == begin1);
+                assert(&v1[0] == begin2);
+            }
+            assert(v1[0] == 0 && v1[2] == 2);
+            assert(v2[0] == 42 && v2[1] == 666);
+            assert(v1.GetSize() == size2);
+            assert(v2.GetSize() == size1);
+            assert(v1.GetCapacity() == capacity2);
+            assert(v2.GetCapacity() == capacity1);
+        }
+
+        template <template <typename> typename Vector>
+        void CopyAssignment() {
+            Vector<int> src_vector{ 1, 2, 3, 4 };
+            Vector<int> dst_vector{ 1, 2, 3, 4, 5, 6 };
+            dst_vector = src_vector;
+            assert(dst_vector == src_vector);
+        }
+
+        template <template <typename> typename Vector>
+        void Insert() {
+            Vector<int> v{ 1, 2, 3, 4 };
+            v.Insert(v.begin() + 2, 42);
+            assert((v == Vector<int>{1, 2, 42, 3, 4}));
+        }
+
+        template <template <typename> typename Vector>
+        void Emplace() {
+            using namespace std::string_literals;
+            {
+                Vector<detail::X> v;
+                detail::X& x = v.EmplaceBack(7u);
+                assert(x.GetX() == 7);
+                v.EmplaceBack();
+                const auto it = v.Emplace(v.begin() + 1, 3u);
+                assert(it == v.begin() + 1);
+                assert(v[0].GetX() == 7 && v[1].GetX() == 3 && v[2].GetX() == 5);
+            }
+            {
+                // Создание элемента на месте не перемещает его
+                Vector<detail::Relocatable> v;
+                v.Reserve(2);
+                detail::Relocatable::moves = 0;
+                v.EmplaceBack(1);
+                v.Emplace(v.begin(), 0);
+                v.EmplaceBack(2);
+                assert(detail::Relocatable::moves == 0);
+                assert(v[0].GetValue() == 0 && v[1].GetValue() == 1 && v[2].GetValue() == 2);
+            }
+            {
+                // Аргументы, ссылающиеся на элементы вектора, остаются действительными
+                Vector<std::string> v{ "a"s, "b"s, "c"s };
+                v.Reserve(10);
+                v.Emplace(v.begin(), v[2]);
+                assert((v == Vector<std::string>{"c"s, "a"s, "b"s, "c"s}));
+                while (v.GetSize() < v.GetCapacity()) {
+                    v.EmplaceBack("x"s);
+                }
+                v.EmplaceBack(v[1]);
+                assert(v[v.GetSize() - 1] == "a"s);
+                v.Emplace(v.begin() + 1, v[0], 0, 1);
+                assert(v[1] == "c"s);
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void RangeInsert() {
+            using namespace std::string_literals;
+            {
+                // Конструктор из двунаправленных итераторов выделяет память ровно под элементы
+                const std::list<int> source{ 1, 2, 3 };
+                Vector<int> v(source.begin(), source.end());
+                assert((v == Vector<int>{1, 2, 3}));
+                assert(v.GetCapacity() == 3);
+
+                // Конструктор из итераторов ввода
+                std::istringstream input("4 5 6"s);
+                Vector<int> from_stream(std::istream_iterator<int>(input), std::istream_iterator<int>{});
+                assert((from_stream == Vector<int>{4, 5, 6}));
+            }
+            {
+                // Хвост длиннее вставляемого диапазона и короче его, с перераспределением памяти и без
+                Vector<std::string> v{ "a"s, "b"s, "c"s, "d"s };
+                const std::string middle[] = { "x"s, "y"s };
+                auto it = v.Insert(v.begin() + 1, std::begin(middle), std::end(middle));
+                assert(it == v.begin() + 1);
+                assert((v == Vector<std::string>{"a"s, "x"s, "y"s, "b"s, "c"s, "d"s}));
+
+                v.Reserve(20);
+                const std::list<std::string> many{ "1"s, "2"s, "3"s, "4"s };
+                v.Insert(v.begin() + 5, many.begin(), many.end());
+                assert((v == Vector<std::string>{"a"s, "x"s, "y"s, "b"s, "c"s, "1"s, "2"s, "3"s, "4"s, "d"s}));
+                v.Insert(v.begin(), { "z"s });
+                assert(v[0] == "z"s && v.GetSize() == 11);
+
+                std::istringstream input("p q"s);
+                v.Insert(v.begin() + 1, std::istream_iterator<std::string>(input), std::istream_iterator<std::string>{});
+                assert(v[1] == "p"s && v[2] == "q"s && v[3] == "a"s && v.GetSize() == 13);
+            }
+            {
+                Vector<int> v{ 1, 2, 3 };
+                v.Insert(v.begin() + 1, 3, v[2]);
+                assert((v == Vector<int>{1, 3, 3, 3, 2, 3}));
+                v.Insert(v.end(), 0, 7);
+                assert(v.GetSize() == 6);
+
+                const Vector<int> tail{ 8, 9 };
+                v.Append(tail);
+                v.Append({ 10 });
+                const int numbers[] = { 11, 12 };
+                v.Append(numbers);
+                assert((v == Vector<int>{1, 3, 3, 3, 2, 3, 8, 9, 10, 11, 12}));
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void Erase() {
+            Vector<int> v{ 1, 2, 3, 4 };
+            v.Erase(v.cbegin() + 2);
+            assert((v == Vector<int>{1, 2, 4}));
+        }
+
+        template <template <typename> typename Vector>
+        void EraseRange() {
+            using namespace std::string_literals;
+            {
+                Vector<int> v{ 1, 2, 3, 4, 5, 6 };
+                auto it = v.Erase(v.begin() + 1, v.begin() + 3);
+                assert(*it == 4);
+                assert((v == Vector<int>{1, 4, 5, 6}));
+                it = v.Erase(v.begin(), v.begin());
+                assert(it == v.begin() && v.GetSize() == 4);
+                it = v.Erase(v.begin() + 2, v.end());
+                assert(it == v.end());
+                assert((v == Vector<int>{1, 4}));
+            }
+            {
+                Vector<std::string> v{ "a"s, "b"s, "c"s, "d"s, "e"s };
+                v.Erase(v.begin(), v.begin() + 2);
+                assert((v == Vector<std::string>{"c"s, "d"s, "e"s}));
+            }
+            {
+                Vector<int> v{ 1, 2, 3, 2, 5, 2 };
+                assert(Erase(v, 2) == 3);
+                assert((v == Vector<int>{1, 3, 5}));
+                assert(EraseIf(v, [](int x) { return x > 1; }) == 2);
+                assert((v == Vector<int>{1}));
+                assert(Erase(v, 42) == 0);
+            }
+            {
+                Vector<std::string> v{ "a"s, "bb"s, "c"s, "dd"s };
+                assert(EraseIf(v, [](const std::string& s) { return s.size() == 2; }) == 2);
+                assert((v == Vector<std::string>{"a"s, "c"s}));
+            }
+            {
+                Vector<std::string> v{ "a"s, "b"s, "c"s, "d"s };
+                auto it = v.UnorderedErase(v.begin() + 1);
+                assert(*it == "d"s);
+                assert((v == Vector<std::string>{"a"s, "d"s, "c"s}));
+                it = v.UnorderedErase(v.end() - 1);
+                assert(it == v.end());
+                assert((v == Vector<std::string>{"a"s, "d"s}));
+
+                Vector<int> numbers{ 1, 2, 3 };
+                numbers.UnorderedErase(numbers.begin());
+                assert((numbers == Vector<int>{3, 2}));
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void ShrinkToFit() {
+            using namespace std::string_literals;
+            {
+                Vector<int> v;
+                for (int i = 0; i < 100; ++i) {
+                    v.PushBack(i);
+                }
+                v.Erase(v.begin() + 10, v.end());
+                assert(v.GetCapacity() > v.GetSize());
+                v.ShrinkToFit();
+                assert(v.GetCapacity() == 10);
+                assert(v.GetSize() == 10);
+                assert(v[9] == 9);
+
+                // Повторный вызов ничего не меняет, а после очистки память освобождается полностью
+                v.ShrinkToFit();
+                assert(v.GetCapacity() == 10);
+                v.Clear();
+                v.ShrinkToFit();
+                assert(v.GetCapacity() == 0);
+                v.PushBack(1);
+                assert(v.GetCapacity() == 1 && v[0] == 1);
+            }
+            {
+                Vector<std::string> v{ "a"s, "b"s, "c"s };
+                v.Reserve(50);
+                v.ShrinkToFit();
+                assert(v.GetCapacity() == 3);
+                assert((v == Vector<std::string>{"a"s, "b"s, "c"s}));
+            }
+            {
+                Vector<detail::Counted> v;
+                v.Reserve(10);
+                v.PushBack(detail::Counted(1));
+                v.ShrinkToFit();
+                assert(v.GetCapacity() == 1);
+                assert(detail::Counted::alive == 1);
+            }
+            assert(detail::Counted::alive == 0);
+        }
+
+        template <template <typename> typename Vector>
+        void MoveConstructor() {
+            const size_t size = 1000000;
+            Vector<int> vector_to_move = GenerateVector<Vector>(size);
+            assert(vector_to_move.GetSize() == size);
+
+            Vector<int> moved_vector(std::move(vector_to_move));
+            assert(moved_vector.GetSize() == size);
+            assert(vector_to_move.GetSize() == 0);
+        }
+
+        template <template <typename> typename Vector>
+        void MoveAssignment() {
+            const size_t size = 1000000;
+            Vector<int> moved_vector;
+            assert(moved_vector.GetSize() == 0);
+            Vector<int> vector_to_move = GenerateVector<Vector>(size);
+            assert(vector_to_move.GetSize() == size);
+
+            moved_vector = std::move(vector_to_move);
+            assert(moved_vector.GetSize() == size);
+            assert(vector_to_move.GetSize() == 0);
+        }
+
+        template <template <typename> typename Vector>
+        void NoncopiableMoveConstructor() {
+            const size_t size = 5;
+            Vector<detail::X> vector_to_move;
+            for (size_t i = 0; i < size; ++i) {
+                vector_to_move.PushBack(detail::X(i));
+            }
+
+            Vector<detail::X> moved_vector = std::move(vector_to_move);
+            assert(moved_vector.GetSize() == size);
+            assert(vector_to_move.GetSize() == 0);
+
+            for (size_t i = 0; i < size; ++i) {
+                assert(moved_vector[i].GetX() == i);
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void NoncopiablePushBack() {
+            const size_t size = 5;
+            Vector<detail::X> v;
+            for (size_t i = 0; i < size; ++i) {
+                v.PushBack(detail::X(i));
+            }
+
+            assert(v.GetSize() == size);
+
+            for (size_t i = 0; i < size; ++i) {
+                assert(v[i].GetX() == i);
+            }
+        }
+
+        template <template <typename> typename Vector>
+        void NoncopiableInsert() {
+            const size_t size = 5;
+            Vector<detail::X> v;
+            for (size_t i = 0; i < size; ++i) {
+                v.PushBack(detail::X(i));
+            }
+
+            // в начало
+            v.Insert(v.begin(), detail::X(size + 1));
+            assert(v.GetSize() == size + 1);
+            assert(v.begin()->GetX() == size + 1);
+            // в конец
+            v.Insert(v.end(), detail::X(size + 2));
+            assert(v.GetSize() == size + 2);
+            assert((v.end() - 1)->GetX() == size + 2);
+            // в середину
+            v.Insert(v.begin() + 3, detail::X(size + 3));
+            assert(v.GetSize() == size + 3);
+            assert((v.begin() + 3)->GetX() == size + 3);
+        }
+
+        template <template <typename> typename Vector>
+        void NoncopiableErase() {
+            const size_t size = 3;
+            Vector<detail::X> v;
+            for (size_t i = 0; i < size; ++i) {
+                v.PushBack(detail::X(i));
+            }
+
+            auto it = v.Erase(v.begin());
+            assert(it->GetX() == 1);
+        }
+
+        // Повторы тестов выше, пригодные для вычисления во время компиляции (C++20).
+        // Каждый возвращает true, если все проверки выполнены
+
+        SIMPLE_VECTOR_CONSTEXPR bool ConstexprConstruction() {
+            SimpleVector<int> v{ 1, 2, 3 };
+            SimpleVector<int> filled(3, 42);
+            const SimpleVector<int> copy(v);
+            return v.GetSize() == 3 && v.GetCapacity() == 3 && v[2] == 3
+                && filled.GetSize() == 3 && filled[0] == 42 && filled[2] == 42
+                && copy == v && copy.begin() != v.begin();
+        }
+
+        SIMPLE_VECTOR_CONSTEXPR bool ConstexprPushBack() {
+            SimpleVector<int> v(1);
+            v.PushBack(42);
+            const bool pushed = v.GetSize() == 2 && v.GetCapacity() >= v.GetSize() && v[0] == 0 && v[1] == 42;
+
+            // Если хватает места, PushBack не увеличивает Capacity
+            SimpleVector<int> w(2);
+            w.Resize(1);
+            const size_t old_capacity = w.GetCapacity();
+            w.PushBack(123);
+            return pushed && w.GetSize() == 2 && w.GetCapacity() == old_capacity;
+        }
+
+        SIMPLE_VECTOR_CONSTEXPR bool ConstexprInsert() {
+            SimpleVector<int> v{ 1, 2, 3, 4 };
+            v.Insert(v.begin() + 2, 42);
+            SimpleVector<int> w{ 1, 2, 3 };
+            w.Insert(w.begin() + 1, 3, w[2]);
+            w.Insert(w.begin(), { 0 });
+
+            // Элементы без тривиальной перемещаемости переносятся по одному
+            SimpleVector<SimpleVector<int>> nested;
+            nested.PushBack(SimpleVector<int>{ 2 });
+            nested.Insert(nested.begin(), SimpleVector<int>{ 1 });
+            nested.EmplaceBack(2, 3);
+            return v == SimpleVector<int>{ 1, 2, 42, 3, 4 } && w == SimpleVector<int>{ 0, 1, 3, 3, 3, 2, 3 }
+                && nested.GetSize() == 3 && nested[0][0] == 1 && nested[1][0] == 2 && nested[2] == SimpleVector<int>{ 3, 3 };
+        }
+
+        SIMPLE_VECTOR_CONSTEXPR bool ConstexprErase() {
+            SimpleVector<int> v{ 1, 2, 3, 4 };
+            v.Erase(v.cbegin() + 2);
+            SimpleVector<int> w{ 1, 2, 3, 4, 5, 6 };
+            const auto it = w.Erase(w.begin() + 1, w.begin() + 3);
+            SimpleVector<SimpleVector<int>> nested{ SimpleVector<int>{ 1 }, SimpleVector<int>{ 2 }, SimpleVector<int>{ 3 } };
+            nested.Erase(nested.begin());
+            return v == SimpleVector<int>{ 1, 2, 4 } && *it == 4 && w == SimpleVector<int>{ 1, 4, 5, 6 }
+                && nested.GetSize() == 2 && nested[0][0] == 2 && nested[1][0] == 3;
+        }
+
+        SIMPLE_VECTOR_CONSTEXPR bool ConstexprResize() {
+            SimpleVector<int> v(3);
+            v[2] = 17;
+            v.Resize(7);
+            const bool grown = v.GetSize() == 7 && v[2] == 17 && v[3] == 0;
+
+            const size_t old_capacity = v.GetCapacity();
+            v.Resize(2);
+            const bool shrunk = v.GetSize() == 2 && v.GetCapacity() == old_capacity;
+
+            v.Resize(5);
+            v[3] = 42;
+            v.Resize(3);
+            v.Resize(5);
+            v.ShrinkToFit();
+            return grown && shrunk && v[3] == 0 && v.GetCapacity() == 5;
+        }
+
+        SIMPLE_VECTOR_CONSTEXPR bool ConstexprCompare() {
+            return SimpleVector<int>{ 1, 2, 3 } == SimpleVector<int>{ 1, 2, 3 }
+                && SimpleVector<int>{ 1, 2, 3 } != SimpleVector<int>{ 1, 2, 2 }
+                && SimpleVector<int>{ 1, 2, 3 } < SimpleVector<int>{ 1, 2, 3, 1 }
+                && SimpleVector<int>{ 1, 2, 3 } > SimpleVector<int>{ 1, 2, 2, 1 }
+                && SimpleVector<int>{ 1, 2, 3 } >= SimpleVector<int>{ 1, 2, 3 }
+                && SimpleVector<int>{ 1, 2, 3 } <= SimpleVector<int>{ 1, 2, 4 }
+                && SimpleVector<int>{ -1 } < SimpleVector<int>{ 1 }
+                && SimpleVector<char>{ 'a', 'b' } < SimpleVector<char>{ 'a', 'c' };
+        }
+
+        // Таблица квадратов, построенная вектором во время компиляции
+        SIMPLE_VECTOR_CONSTEXPR SimpleVector<int> BuildSquares() {
+            SimpleVector<int> squares;
+            for (int i = 0; i < 10; ++i) {
+                squares.PushBack(i * i);
+            }
+            Erase(squares, 49);
+            return squares;
+        }
+
     }
 
     void DefaultConstructor() {
         using namespace std::string_literals;
         std::cout << "Test default constructor"s << std::endl;
-        SimpleVector<int> v;
-        assert(v.GetSize() == 0u);
-        assert(v.IsEmpty());
-        assert(v.GetCapacity() == 0u);
+        detail::DefaultConstructor<SimpleVector>();
+        detail::RunWithResource(detail::DefaultConstructor<pmr::SimpleVector>);
+        detail::DefaultConstructor<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void SizeConstructor() {
         using namespace std::string_literals;
         std::cout << "Test size constructor"s << std::endl;
-        SimpleVector<int> v(5);
-        assert(v.GetSize() == 5u);
-        assert(v.GetCapacity() == 5u);
-        assert(!v.IsEmpty());
-        for (size_t i = 0; i < v.GetSize(); ++i) {
-            assert(v[i] == 0);
-        }
+        detail::SizeConstructor<SimpleVector>();
+        detail::RunWithResource(detail::SizeConstructor<pmr::SimpleVector>);
+        detail::SizeConstructor<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void SizeValueConstructor() {
         using namespace std::string_literals;
         std::cout << "Test size & value constructor"s << std::endl;
-        SimpleVector<int> v(3, 42);
-        assert(v.GetSize() == 3);
-        assert(v.GetCapacity() == 3);
-        for (size_t i = 0; i < v.GetSize(); ++i) {
-            assert(v[i] == 42);
-        }
+        detail::SizeValueConstructor<SimpleVector>();
+        detail::RunWithResource(detail::SizeValueConstructor<pmr::SimpleVector>);
+        detail::SizeValueConstructor<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void InitializerListConstructor() {
         using namespace std::string_literals;
         std::cout << "Test initializer list constructor"s << std::endl;
-        SimpleVector<int> v{ 1, 2, 3 };
-        assert(v.GetSize() == 3);
-        assert(v.GetCapacity() == 3);
-        assert(v[2] == 3);
+        detail::InitializerListConstructor<SimpleVector>();
+        detail::RunWithResource(detail::InitializerListConstructor<pmr::SimpleVector>);
+        detail::InitializerListConstructor<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void At() {
         using namespace std::string_literals;
         std::cout << "Test at"s << std::endl;
-        SimpleVector<int> v(3);
-        assert(&v.At(2) == &v[2]);
-        try {
-            v.At(3);
-            assert(false); 
-        }
-        catch (const std::out_of_range&) {
-        }
-        catch (...) {
-            assert(false); 
-        }
+        detail::At<SimpleVector>();
+        detail::RunWithResource(detail::At<pmr::SimpleVector>);
+        detail::At<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void Clear() {
         using namespace std::string_literals;
         std::cout << "Test clear"s << std::endl;
-        SimpleVector<int> v(10);
-        const size_t old_capacity = v.GetCapacity();
-        v.Clear();
-        assert(v.GetSize() == 0);
-        assert(v.GetCapacity() == old_capacity);
+        detail::Clear<SimpleVector>();
+        detail::RunWithResource(detail::Clear<pmr::SimpleVector>);
+        detail::Clear<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void Resize() {
         using namespace std::string_literals;
         std::cout << "Test resize"s << std::endl;
-        {
-            SimpleVector<int> v(3);
-            v[2] = 17;
-            v.Resize(7);
-            assert(v.GetSize() == 7);
-            assert(v.GetCapacity() >= v.GetSize());
-            assert(v[2] == 17);
-            assert(v[3] == 0);
-        }
-        {
-            SimpleVector<int> v(3);
-            v[0] = 42;
-            v[1] = 55;
-            const size_t old_capacity = v.GetCapacity();
-            v.Resize(2);
-            assert(v.GetSize() == 2);
-            assert(v.GetCapacity() == old_capacity);
-            assert(v[0] == 42);
-            assert(v[1] == 55);
-        }
-        {
-            const size_t old_size = 3;
-            SimpleVector<int> v(3);
-            v.Resize(old_size + 5);
-            v[3] = 42;
-            v.Resize(old_size);
-            v.Resize(old_size + 2);
-            assert(v[3] == 0);
-        }
+        detail::Resize<SimpleVector>();
+        detail::RunWithResource(detail::Resize<pmr::SimpleVector>);
+        detail::Resize<detail::SmallVector>();
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void Reserve() {
+        using namespace std::string_literals;
+        std::cout << "Test reserve"s << std::endl;
+        detail::Reserve<SimpleVector>();
+        detail::RunWithResource(detail::Reserve<pmr::SimpleVector>);
+        detail::Reserve<detail::SmallVector>();
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void NonDefaultConstructible() {
+        using namespace std::string_literals;
+        std::cout << "Test non default constructible"s << std::endl;
+        detail::NonDefaultConstructible<SimpleVector>();
+        detail::RunWithResource(detail::NonDefaultConstructible<pmr::SimpleVector>);
+        detail::NonDefaultConstructible<detail::SmallVector>();
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void TriviallyRelocatable() {
+        using namespace std::string_literals;
+        std::cout << "Test trivially relocatable"s << std::endl;
+        detail::TriviallyRelocatable<SimpleVector>();
+        detail::RunWithResource(detail::TriviallyRelocatable<pmr::SimpleVector>);
+        detail::TriviallyRelocatable<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void Iterate() {
         using namespace std::string_literals;
         std::cout << "Test iterate"s << std::endl;
-        {
-            SimpleVector<int> v;
-            assert(v.begin() == nullptr);
-            assert(v.end() == nullptr);
-        }
-        {
-            SimpleVector<int> v(10, 42);
-            assert(v.begin());
-            assert(*v.begin() == 42);
-            assert(v.end() == v.begin() + v.GetSize());
-        }
+        detail::Iterate<SimpleVector>();
+        detail::RunWithResource(detail::Iterate<pmr::SimpleVector>);
+        detail::Iterate<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void PushBack() {
         using namespace std::string_literals;
         std::cout << "Test push back"s << std::endl;
-        {
-            SimpleVector<int> v(1);
-            v.PushBack(42);
-            assert(v.GetSize() == 2);
-            assert(v.GetCapacity() >= v.GetSize());
-            assert(v[0] == 0);
-            assert(v[1] == 42);
-        }
-
-        // Если хватает места, PushBack не увеличивает Capacity
-        {    
-            SimpleVector<int> v(2);
-            v.Resize(1);
-            const size_t old_capacity = v.GetCapacity();
-            v.PushBack(123);
-            assert(v.GetSize() == 2);
-            assert(v.GetCapacity() == old_capacity);
-        }
+        detail::PushBack<SimpleVector>();
+        detail::RunWithResource(detail::PushBack<pmr::SimpleVector>);
+        detail::PushBack<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void PopBack() {
         using namespace std::string_literals;
         std::cout << "Test pop back"s << std::endl;
-        SimpleVector<int> v{ 0, 1, 2, 3 };
-        const size_t old_capacity = v.GetCapacity();
-        const auto old_begin = v.begin();
-        v.PopBack();
-        assert(v.GetCapacity() == old_capacity);
-        assert(v.begin() == old_begin);
-        assert((v == SimpleVector<int>{0, 1, 2}));
+        detail::PopBack<SimpleVector>();
+        detail::RunWithResource(detail::PopBack<pmr::SimpleVector>);
+        detail::PopBack<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void CopyConstructor() {
         using namespace std::string_literals;
         std::cout << "Test copy constructor"s << std::endl;
-        SimpleVector<int> numbers{ 1, 2 };
-        auto numbers_copy(numbers);
-        assert(&numbers_copy[0] != &numbers[0]);
-        assert(numbers_copy.GetSize() == numbers.GetSize());
-        for (size_t i = 0; i < numbers.GetSize(); ++i) {
-            assert(numbers_copy[i] == numbers[i]);
-            assert(&numbers_copy[i] != &numbers[i]);
-        }
+        detail::CopyConstructor<SimpleVector>();
+        detail::RunWithResource(detail::CopyConstructor<pmr::SimpleVector>);
+        detail::CopyConstructor<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void Compare() {
         using namespace std::string_literals;
         std::cout << "Test compare"s << std::endl;
-        assert((SimpleVector{ 1, 2, 3 } == SimpleVector{ 1, 2, 3 }));
-        assert((SimpleVector{ 1, 2, 3 } != SimpleVector{ 1, 2, 2 }));
-
-        assert((SimpleVector{ 1, 2, 3 } < SimpleVector{ 1, 2, 3, 1 }));
-        assert((SimpleVector{ 1, 2, 3 } > SimpleVector{ 1, 2, 2, 1 }));
-
-        assert((SimpleVector{ 1, 2, 3 } >= SimpleVector{ 1, 2, 3 }));
-        assert((SimpleVector{ 1, 2, 4 } >= SimpleVector{ 1, 2, 3 }));
-        assert((SimpleVector{ 1, 2, 3 } <= SimpleVector{ 1, 2, 3 }));
-        assert((SimpleVector{ 1, 2, 3 } <= SimpleVector{ 1, 2, 4 }));
+        detail::Compare<SimpleVector>();
+        detail::RunWithResource(detail::Compare<pmr::SimpleVector>);
+        detail::Compare<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void Swap() {
         using namespace std::string_literals;
         std::cout << "Test swap"s << std::endl;
-        SimpleVector<int> v1{ 42, 666 };
-        SimpleVector<int> v2;
-        v2.PushBack(0);
-        v2.PushBack(1);
-        v2.PushBack(2);
-        const int* const begin1 = &v1[0];
-        const int* const begin2 = &v2[0];
-
-        const size_t capacity1 = v1.GetCapacity();
-        const size_t capacity2 = v2.GetCapacity();
-
-        const size_t size1 = v1.GetSize();
-        const size_t size2 = v2.GetSize();
-
-        v1.swap(v2);
-        assert(&v2[0] == begin1);
-        assert(&v1[0] == begin2);
-        assert(v1.GetSize() == size2);
-        assert(v2.GetSize() == size1);
-        assert(v1.GetCapacity() == capacity2);
-        assert(v2.GetCapacity() == capacity1);
+        detail::Swap<SimpleVector>();
+        detail::RunWithResource(detail::Swap<pmr::SimpleVector>);
+        detail::Swap<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void CopyAssignment() {
         using namespace std::string_literals;
         std::cout << "Test copy assignment"s << std::endl;
-        SimpleVector<int> src_vector{ 1, 2, 3, 4 };
-        SimpleVector<int> dst_vector{ 1, 2, 3, 4, 5, 6 };
-        dst_vector = src_vector;
-        assert(dst_vector == src_vector);
+        detail::CopyAssignment<SimpleVector>();
+        detail::RunWithResource(detail::CopyAssignment<pmr::SimpleVector>);
+        detail::CopyAssignment<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void Insert() {
         using namespace std::string_literals;
         std::cout << "Test insert"s << std::endl;
-        SimpleVector<int> v{ 1, 2, 3, 4 };
-        v.Insert(v.begin() + 2, 42);
-        assert((v == SimpleVector<int>{1, 2, 42, 3, 4}));
+        detail::Insert<SimpleVector>();
+        detail::RunWithResource(detail::Insert<pmr::SimpleVector>);
+        detail::Insert<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void Erase() {
         using namespace std::string_literals;
         std::cout << "Test erase"s << std::endl;
-        SimpleVector<int> v{ 1, 2, 3, 4 };
-        v.Erase(v.cbegin() + 2);
-        assert((v == SimpleVector<int>{1, 2, 4}));
+        detail::Erase<SimpleVector>();
+        detail::RunWithResource(detail::Erase<pmr::SimpleVector>);
+        detail::Erase<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void MoveConstructor() {
         using namespace std::string_literals;
-        const size_t size = 1000000;
         std::cout << "Test move constructor"s << std::endl;
-        SimpleVector<int> vector_to_move = detail::GenerateVector(size);
-        assert(vector_to_move.GetSize() == size);
-
-        SimpleVector<int> moved_vector(std::move(vector_to_move));
-        assert(moved_vector.GetSize() == size);
-        assert(vector_to_move.GetSize() == 0);
+        detail::MoveConstructor<SimpleVector>();
+        detail::RunWithResource(detail::MoveConstructor<pmr::SimpleVector>);
+        detail::MoveConstructor<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void MoveAssignment() {
         using namespace std::string_literals;
-        const size_t size = 1000000;
         std::cout << "Test move assignment"s << std::endl;
-        SimpleVector<int> moved_vector;
-        assert(moved_vector.GetSize() == 0);
-        SimpleVector<int> vector_to_move = detail::GenerateVector(size);
-        assert(vector_to_move.GetSize() == size);
-
-        moved_vector = std::move(vector_to_move);
-        assert(moved_vector.GetSize() == size);
-        assert(vector_to_move.GetSize() == 0);
+        detail::MoveAssignment<SimpleVector>();
+        detail::RunWithResource(detail::MoveAssignment<pmr::SimpleVector>);
+        detail::MoveAssignment<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void NoncopiableMoveConstructor() {
         using namespace std::string_literals;
-        const size_t size = 5;
         std::cout << "Test noncopiable object, move constructor"s << std::endl;
-        SimpleVector<detail::X> vector_to_move;
-        for (size_t i = 0; i < size; ++i) {
-            vector_to_move.PushBack(detail::X(i));
-        }
-
-        SimpleVector<detail::X> moved_vector = std::move(vector_to_move);
-        assert(moved_vector.GetSize() == size);
-        assert(vector_to_move.GetSize() == 0);
-
-        for (size_t i = 0; i < size; ++i) {
-            assert(moved_vector[i].GetX() == i);
-        }
+        detail::NoncopiableMoveConstructor<SimpleVector>();
+        detail::RunWithResource(detail::NoncopiableMoveConstructor<pmr::SimpleVector>);
+        detail::NoncopiableMoveConstructor<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void NoncopiablePushBack() {
         using namespace std::string_literals;
-        const size_t size = 5;
         std::cout << "Test noncopiable push back"s << std::endl;
-        SimpleVector<detail::X> v;
-        for (size_t i = 0; i < size; ++i) {
-            v.PushBack(detail::X(i));
-        }
-
-        assert(v.GetSize() == size);
-
-        for (size_t i = 0; i < size; ++i) {
-            assert(v[i].GetX() == i);
-        }
+        detail::NoncopiablePushBack<SimpleVector>();
+        detail::RunWithResource(detail::NoncopiablePushBack<pmr::SimpleVector>);
+        detail::NoncopiablePushBack<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void NoncopiableInsert() {
         using namespace std::string_literals;
-        const size_t size = 5;
         std::cout << "Test noncopiable insert"s << std::endl;
-        SimpleVector<detail::X> v;
-        for (size_t i = 0; i < size; ++i) {
-            v.PushBack(detail::X(i));
-        }
-
-        // в начало
-        v.Insert(v.begin(), detail::X(size + 1));
-        assert(v.GetSize() == size + 1);
-        assert(v.begin()->GetX() == size + 1);
-        // в конец
-        v.Insert(v.end(), detail::X(size + 2));
-        assert(v.GetSize() == size + 2);
-        assert((v.end() - 1)->GetX() == size + 2);
-        // в середину
-        v.Insert(v.begin() + 3, detail::X(size + 3));
-        assert(v.GetSize() == size + 3);
-        assert((v.begin() + 3)->GetX() == size + 3);
+        detail::NoncopiableInsert<SimpleVector>();
+        detail::RunWithResource(detail::NoncopiableInsert<pmr::SimpleVector>);
+        detail::NoncopiableInsert<detail::SmallVector>();
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
     void NoncopiableErase() {
         using namespace std::string_literals;
-        const size_t size = 3;
         std::cout << "Test noncopiable erase"s << std::endl;
-        SimpleVector<detail::X> v;
-        for (size_t i = 0; i < size; ++i) {
-            v.PushBack(detail::X(i));
+        detail::NoncopiableErase<SimpleVector>();
+        detail::RunWithResource(detail::NoncopiableErase<pmr::SimpleVector>);
+        detail::NoncopiableErase<detail::SmallVector>();
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void PmrResource() {
+        using namespace std::string_literals;
+        std::cout << "Test pmr resource"s << std::endl;
+        detail::CountingResource resource1;
+        detail::CountingResource resource2;
+        {
+            pmr::SimpleVector<int> v(&resource1);
+            for (int i = 0; i < 100; ++i) {
+                v.PushBack(i);
+            }
+            assert(resource1.GetAllocations() > 0);
+            assert(resource2.GetAllocations() == 0);
+
+            pmr::SimpleVector<int> copy(v, &resource2);
+            assert(copy.GetAllocator().resource() == &resource2);
+            assert(copy == v);
+
+            // Перемещение сохраняет ресурс исходного вектора
+            pmr::SimpleVector<int> moved(std::move(v));
+            assert(moved.GetAllocator().resource() == &resource1);
+            assert(v.GetSize() == 0);
+
+            // Аллокатор pmr не распространяется при присваивании: элементы переносятся в память ресурса приемника
+            const size_t allocations = resource2.GetAllocations();
+            copy = std::move(moved);
+            assert(copy.GetAllocator().resource() == &resource2);
+            assert(resource2.GetAllocations() == allocations + 1);
+            assert(copy.GetSize() == 100);
+            assert(copy[99] == 99);
+
+            moved = copy;
+            assert(moved.GetAllocator().resource() == &resource1);
+            assert(moved == copy);
+        }
+        assert(resource1.GetBytesInUse() == 0);
+        assert(resource2.GetBytesInUse() == 0);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void AllocatorPropagation() {
+        using namespace std::string_literals;
+        std::cout << "Test allocator propagation"s << std::endl;
+        using Allocator = detail::TaggedAllocator<int>;
+        using Vector = SimpleVector<int, Allocator>;
+
+        Vector v1({ 1, 2, 3 }, Allocator(1));
+        Vector v2({ 4, 5 }, Allocator(2));
+
+        Vector copy(v1);
+        assert(copy.GetAllocator().tag == 1);
+
+        v2 = v1;
+        assert(v2.GetAllocator().tag == 1);
+        assert(v2 == v1);
+
+        Vector v3({ 6 }, Allocator(3));
+        v3.swap(v1);
+        assert(v1.GetAllocator().tag == 3);
+        assert(v3.GetAllocator().tag == 1);
+        assert((v1 == Vector{ 6 }));
+
+        v2 = std::move(v1);
+        assert(v2.GetAllocator().tag == 3);
+        assert((v2 == Vector{ 6 }));
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void SmallVectorInline() {
+        using namespace std::string_literals;
+        std::cout << "Test small vector inline storage"s << std::endl;
+        detail::CountingResource resource;
+        {
+            SmallSimpleVector<int, 4, std::pmr::polymorphic_allocator<int>> v(&resource);
+            for (int i = 0; i < 4; ++i) {
+                v.PushBack(i);
+            }
+            assert(v.IsInline());
+            assert(v.GetCapacity() == 4);
+            assert(resource.GetAllocations() == 0);
+
+            // Пятый элемент переносит вектор в кучу
+            v.PushBack(4);
+            assert(!v.IsInline());
+            assert(v.GetCapacity() == 8);
+            assert(resource.GetAllocations() == 1);
+            assert((v == SmallSimpleVector<int, 4, std::pmr::polymorphic_allocator<int>>({ 0, 1, 2, 3, 4 }, &resource)));
         }
+        assert(resource.GetBytesInUse() == 0);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void SmallVectorSwapAndMove() {
+        using namespace std::string_literals;
+        std::cout << "Test small vector swap and move"s << std::endl;
+        using Vector = SmallSimpleVector<detail::Counted, 2>;
+        {
+            const auto make = [](int size) {
+                Vector v;
+                for (int i = 0; i < size; ++i) {
+                    v.PushBack(detail::Counted(size * 10 + i));
+                }
+                return v;
+            };
+            const auto check = [](const Vector& v, int size) {
+                assert(v.GetSize() == static_cast<size_t>(size));
+                for (int i = 0; i < size; ++i) {
+                    assert(v[i].GetValue() == size * 10 + i);
+                }
+            };
+
+            // Встроенный буфер <-> встроенный буфер
+            Vector a = make(1);
+            Vector b = make(2);
+            a.swap(b);
+            check(a, 2);
+            check(b, 1);
+            assert(a.IsInline() && b.IsInline());
+
+            // Встроенный буфер <-> куча
+            Vector c = make(5);
+            const detail::Counted* const heap_begin = &c[0];
+            a.swap(c);
+            check(a, 5);
+            check(c, 2);
+            assert(&a[0] == heap_begin);
+            assert(c.IsInline());
+
+            // Куча <-> куча
+            Vector d = make(3);
+            a.swap(d);
+            check(a, 3);
+            check(d, 5);
+            assert(&d[0] == heap_begin);
+
+            // Перемещение из встроенного буфера и из кучи
+            Vector moved_inline(std::move(b));
+            check(moved_inline, 1);
+            assert(b.IsEmpty());
+            Vector moved_heap(std::move(d));
+            check(moved_heap, 5);
+            assert(&moved_heap[0] == heap_begin);
+
+            moved_heap = std::move(moved_inline);
+            check(moved_heap, 1);
+            assert(moved_heap.IsInline());
+            moved_inline = std::move(a);
+            check(moved_inline, 3);
+            assert(detail::Counted::alive == 1 + 3 + 2);
+        }
+        assert(detail::Counted::alive == 0);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void Emplace() {
+        using namespace std::string_literals;
+        std::cout << "Test emplace"s << std::endl;
+        detail::Emplace<SimpleVector>();
+        detail::RunWithResource(detail::Emplace<pmr::SimpleVector>);
+        detail::Emplace<detail::SmallVector>();
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void RangeInsert() {
+        using namespace std::string_literals;
+        std::cout << "Test range insert"s << std::endl;
+        detail::RangeInsert<SimpleVector>();
+        detail::RunWithResource(detail::RangeInsert<pmr::SimpleVector>);
+
+        // Вставка диапазона из прямых итераторов перераспределяет память не более одного раза
+        detail::CountingResource resource;
+        {
+            pmr::SimpleVector<std::string> v({ "a"s, "b"s }, &resource);
+            const std::list<std::string> source(100, "x"s);
+            v.Insert(v.begin() + 1, source.begin(), source.end());
+            assert(resource.GetAllocations() == 2);
+            assert(v.GetSize() == 102);
+            assert(v[0] == "a"s && v[1] == "x"s && v[101] == "b"s);
+
+            pmr::SimpleVector<int> numbers(&resource);
+            const std::list<int> more(1000, 1);
+            numbers.Append(more);
+            assert(resource.GetAllocations() == 3);
+        }
+        assert(resource.GetBytesInUse() == 0);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void EraseRange() {
+        using namespace std::string_literals;
+        std::cout << "Test erase range"s << std::endl;
+        detail::EraseRange<SimpleVector>();
+        detail::RunWithResource(detail::EraseRange<pmr::SimpleVector>);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void ShrinkToFit() {
+        using namespace std::string_literals;
+        std::cout << "Test shrink to fit"s << std::endl;
+        detail::ShrinkToFit<SimpleVector>();
+        detail::RunWithResource(detail::ShrinkToFit<pmr::SimpleVector>);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void GrowthPolicy() {
+        using namespace std::string_literals;
+        std::cout << "Test growth policy"s << std::endl;
+        // Последовательность вместимостей при добавлении элементов по одному
+        const auto capacities = [](auto vector) {
+            std::vector<size_t> result;
+            for (int i = 0; i < 20; ++i) {
+                if (vector.GetSize() == vector.GetCapacity()) {
+                    vector.PushBack(i);
+                    result.push_back(vector.GetCapacity());
+                }
+                else {
+                    vector.PushBack(i);
+                }
+            }
+            return result;
+        };
+
+        assert((capacities(SimpleVector<int>()) == std::vector<size_t>{1, 2, 4, 8, 16, 32}));
+        assert((capacities(SimpleVector<int, MallocAllocator<int>, OneAndHalfGrowth>())
+            == std::vector<size_t>{1, 2, 3, 4, 6, 9, 13, 19, 28}));
+        assert((capacities(pmr::SimpleVector<int, OneAndHalfGrowth>()) == capacities(SimpleVector<int, MallocAllocator<int>, OneAndHalfGrowth>())));
+
+        // Блоки округляются до классов размеров: 16 байт для малых, четверть степени двойки для средних, страница для крупных
+        using SizeClass = SizeClassGrowth<>;
+        assert(SizeClass::RoundUpToSizeClass(1) == 16);
+        assert(SizeClass::RoundUpToSizeClass(17) == 32);
+        assert(SizeClass::RoundUpToSizeClass(128) == 128);
+        assert(SizeClass::RoundUpToSizeClass(129) == 160);
+        assert(SizeClass::RoundUpToSizeClass(1000) == 1024);
+        assert(SizeClass::RoundUpToSizeClass(1025) == 1280);
+        assert(SizeClass::RoundUpToSizeClass(20000) == 20480);
+        assert((capacities(SimpleVector<int, MallocAllocator<int>, SizeClass>()) == std::vector<size_t>{4, 8, 16, 32}));
+        {
+            // Вместимость никогда не меньше требуемой, даже если класс размеров не кратен размеру элемента
+            SimpleVector<detail::Record24, MallocAllocator<detail::Record24>, SizeClass> v;
+            for (int i = 0; i < 1000; ++i) {
+                v.PushBack(detail::Record24{});
+                assert(v.GetCapacity() >= v.GetSize());
+            }
+            v.Resize(5000);
+            assert(v.GetCapacity() >= 5000);
+        }
+        {
+            // Политика участвует в сравнении и свободных функциях наравне с аллокатором
+            SimpleVector<int, MallocAllocator<int>, SizeClass> a{ 1, 2, 3 };
+            SimpleVector<int, MallocAllocator<int>, SizeClass> b{ 1, 2, 4 };
+            assert(a < b && a != b);
+            assert(Erase(b, 4) == 1);
+            b.PushBack(3);
+            assert(a == b);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void MmapStorage() {
+        using namespace std::string_literals;
+        std::cout << "Test mmap storage"s << std::endl;
+        // Порог в одну страницу, чтобы блоки переходили через него уже на небольших размерах
+        using Allocator = MmapAllocator<int, 4096>;
+        {
+            SimpleVector<int, Allocator> v;
+            for (int i = 0; i < 100000; ++i) {
+                v.PushBack(i);
+            }
+            assert(v.GetSize() == 100000);
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % 4096 == 0);
+            for (int i = 0; i < 100000; ++i) {
+                assert(v[i] == i);
+            }
+
+            // Уменьшение через mremap и обратный переход под порог
+            v.Resize(5000);
+            v.ShrinkToFit();
+            assert(v.GetCapacity() == 5000 && v[4999] == 4999);
+            v.Resize(10);
+            v.ShrinkToFit();
+            assert((v == SimpleVector<int, Allocator>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+            v.Reserve(1 << 20);
+            v.Insert(v.begin(), -1);
+            assert(v[0] == -1 && v[10] == 9 && v.GetSize() == 11);
+        }
+        {
+            SimpleVector<detail::Relocatable, MmapAllocator<detail::Relocatable, 4096>> v;
+            for (int i = 0; i < 10000; ++i) {
+                v.PushBack(detail::Relocatable(i));
+            }
+            assert(v[9999].GetValue() == 9999);
+
+            SimpleVector<detail::Relocatable, MmapAllocator<detail::Relocatable, 4096>> moved(std::move(v));
+            assert(v.IsEmpty() && moved.GetSize() == 10000);
+        }
+        {
+            // Подсказка об огромных страницах не меняет поведения вектора
+            SimpleVector<double, MmapAllocator<double, kDefaultMmapThreshold, true>> v(1 << 19, 1.5);
+            v.PushBack(2.5);
+            assert(v[0] == 1.5 && v[1 << 19] == 2.5);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void CompareKernels() {
+        using namespace std::string_literals;
+        std::cout << "Test compare kernels"s << std::endl;
+        std::mt19937 generator(42);
+        detail::CheckCompareKernels<signed char>(generator);
+        detail::CheckCompareKernels<unsigned short>(generator);
+        detail::CheckCompareKernels<int>(generator);
+        detail::CheckCompareKernels<long long>(generator);
+        detail::CheckCompareKernels<float>(generator);
+        detail::CheckCompareKernels<double>(generator);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void ParallelConstruction() {
+        using namespace std::string_literals;
+        std::cout << "Test parallel construction"s << std::endl;
+        // Нулевой порог включает параллельное выполнение даже для небольших векторов
+        const ParallelExecution execution{ 4, 0 };
+        const size_t size = 100000;
+        {
+            SimpleVector<int> zeros(size, execution);
+            assert(zeros.GetSize() == size);
+            assert(std::all_of(zeros.begin(), zeros.end(), [](int x) { return x == 0; }));
+
+            SimpleVector<int> sevens(size, 7, execution);
+            assert(std::all_of(sevens.begin(), sevens.end(), [](int x) { return x == 7; }));
+
+            std::iota(sevens.begin(), sevens.end(), 0);
+            const SimpleVector<int> copy(sevens, execution);
+            assert(copy == sevens);
+
+            sevens.Resize(size * 3, execution);
+            assert(sevens.GetSize() == size * 3);
+            assert(sevens[size - 1] == static_cast<int>(size - 1) && sevens[size] == 0 && sevens[size * 3 - 1] == 0);
+            sevens.Resize(10, execution);
+            assert(sevens.GetSize() == 10 && sevens[9] == 9);
+
+            // Значение может ссылаться на элемент самого вектора
+            sevens.Fill(sevens[3], execution);
+            assert((sevens == SimpleVector<int>(10, 3)));
+            sevens.Fill(5);
+            assert((sevens == SimpleVector<int>(10, 5)));
+        }
+        {
+            // Части меньше страницы и число потоков больше числа страниц
+            SimpleVector<char> small(3, 'x', ParallelExecution{ 16, 0 });
+            assert((small == SimpleVector<char>{ 'x', 'x', 'x' }));
+            SimpleVector<char> empty(0, 'x', execution);
+            assert(empty.IsEmpty());
+        }
+        {
+            // Части покрывают диапазон ровно один раз, а их границы приходятся на границы страниц,
+            // даже если сам диапазон начинается не с начала страницы
+            for (const size_t element_size : { sizeof(int), sizeof(detail::Record24) }) {
+                const size_t count = 10000;
+                std::vector<char> buffer((count + 1) * element_size);
+                const char* const data = buffer.data() + element_size;
+                std::vector<int> hits(count);
+                std::array<size_t, 16> starts{};
+                std::atomic<size_t> parts{ 0 };
+                ::detail::ParallelFor(data, count, element_size, execution, [&](size_t first, size_t last) {
+                    starts[parts++] = first;
+                    for (size_t i = first; i < last; ++i) {
+                        ++hits[i];
+                    }
+                });
+                assert(parts > 1 && parts <= 4);
+                assert(std::all_of(hits.begin(), hits.end(), [](int x) { return x == 1; }));
+                for (size_t i = 0; i < parts; ++i) {
+                    if (starts[i] != 0) {
+                        const uintptr_t address = reinterpret_cast<uintptr_t>(data + starts[i] * element_size);
+                        assert(address % ::detail::kParallelPageBytes < element_size);
+                    }
+                }
+            }
+        }
+        {
+            // Копирование строк может выбросить исключение, поэтому выполняется в вызывающем потоке
+            SimpleVector<std::string> strings(1000, "abc"s, execution);
+            const SimpleVector<std::string> copy(strings, execution);
+            assert(copy == strings);
+            strings.Fill("x"s, execution);
+            assert(strings[999] == "x"s);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void ThrowingMoveInsert() {
+        using namespace std::string_literals;
+        using detail::ThrowingMove;
+        std::cout << "Test throwing move constructor"s << std::endl;
+        static_assert(!std::is_nothrow_move_constructible_v<ThrowingMove>);
+        {
+            // При росте элементы с бросающим перемещением копируются
+            SimpleVector<ThrowingMove> v;
+            for (int i = 0; i < 5; ++i) {
+                v.EmplaceBack(i);
+            }
+            v.Insert(v.begin() + 1, 2, ThrowingMove(9));
+            v.Emplace(v.begin(), 8);
+            assert(detail::HasValues(v, { 8, 0, 9, 9, 1, 2, 3, 4 }));
+            assert(ThrowingMove::moves == 0);
+        }
+        assert(ThrowingMove::alive == 0);
+        {
+            // Если копирование при росте выбросит исключение, вектор не изменяется
+            SimpleVector<ThrowingMove> v{ ThrowingMove(0), ThrowingMove(1), ThrowingMove(2) };
+            v.ShrinkToFit();
+            const size_t capacity = v.GetCapacity();
+            const ThrowingMove item(7);
+            ThrowingMove::copies_left = 2;
+            try {
+                v.Insert(v.begin() + 1, item);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(detail::HasValues(v, { 0, 1, 2 }) && v.GetCapacity() == capacity);
+            assert(ThrowingMove::alive == 4);
+
+            // Вставка с запасом вместимости тоже не сдвигает хвост на месте
+            ThrowingMove::copies_left = -1;
+            v.Reserve(10);
+            ThrowingMove::copies_left = 4;
+            try {
+                v.Insert(v.begin() + 1, 3, item);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(detail::HasValues(v, { 0, 1, 2 }) && ThrowingMove::alive == 4);
+
+            ThrowingMove::copies_left = -1;
+            v.Insert(v.begin() + 1, 3, item);
+            assert(detail::HasValues(v, { 0, 7, 7, 7, 1, 2 }) && v.GetCapacity() == 10);
+            ThrowingMove::copies_left = 1;
+            try {
+                v.Emplace(v.begin(), 6);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(detail::HasValues(v, { 0, 7, 7, 7, 1, 2 }) && ThrowingMove::alive == 7);
+            ThrowingMove::copies_left = -1;
+        }
+        assert(ThrowingMove::alive == 0);
+        {
+            SmallSimpleVector<ThrowingMove, 2> v;
+            v.EmplaceBack(0);
+            v.EmplaceBack(1);
+            ThrowingMove::copies_left = 1;
+            try {
+                v.Emplace(v.begin() + 1, 5);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(detail::HasValues(v, { 0, 1 }) && ThrowingMove::alive == 2);
+
+            ThrowingMove::copies_left = -1;
+            v.Emplace(v.begin() + 1, 5);
+            assert(detail::HasValues(v, { 0, 5, 1 }));
+        }
+        {
+            // Со свободным местом во встроенном буфере хвост тоже не сдвигается на месте
+            SmallSimpleVector<ThrowingMove, 4> v;
+            v.EmplaceBack(0);
+            v.EmplaceBack(1);
+            v.EmplaceBack(2);
+            ThrowingMove::copies_left = 1;
+            try {
+                v.Emplace(v.begin(), 5);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(detail::HasValues(v, { 0, 1, 2 }) && v.GetCapacity() == 4 && ThrowingMove::alive == 3);
+
+            ThrowingMove::copies_left = -1;
+            v.Emplace(v.begin() + 1, 6);
+            assert(detail::HasValues(v, { 0, 6, 1, 2 }) && v.GetCapacity() == 4);
+        }
+        assert(ThrowingMove::alive == 0 && ThrowingMove::moves == 0);
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void ConcurrentPushBack() {
+        using namespace std::string_literals;
+        std::cout << "Test concurrent push back"s << std::endl;
+        static_assert(::detail::SegmentIndex<4>::Locate(0).segment == 0);
+        static_assert(::detail::SegmentIndex<4>::Locate(3).offset == 3);
+        static_assert(::detail::SegmentIndex<4>::Locate(4).segment == 1);
+        static_assert(::detail::SegmentIndex<4>::Locate(11).segment == 1 && ::detail::SegmentIndex<4>::Locate(11).offset == 7);
+        static_assert(::detail::SegmentIndex<4>::Locate(12).segment == 2);
+        static_assert(::detail::SegmentIndex<4>::SegmentCount(12) == 2);
+
+        const size_t writers = 8;
+        const size_t per_writer = 20000;
+        {
+            // Маленький первый сегмент, чтобы потоки часто одновременно выделяли новые сегменты
+            ConcurrentSimpleVector<size_t, MallocAllocator<size_t>, 2> v;
+            std::atomic<bool> done{ false };
+            std::atomic<size_t> checked{ 0 };
+
+            // Читатель проверяет опубликованные элементы и их адреса одновременно с добавлением
+            std::thread reader([&v, &done, &checked] {
+                const size_t* first = nullptr;
+                while (!done.load()) {
+                    const size_t size = v.GetSize();
+                    for (size_t i = 0; i < size; ++i) {
+                        if (const size_t* item = v.TryGet(i)) {
+                            assert(*item / per_writer < writers);
+                            checked.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                    if (!first && v.IsPublished(0)) {
+                        first = &v[0];
+                    }
+                    assert(!first || first == &v[0]);
+                }
+            });
+
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < writers; ++t) {
+                threads.emplace_back([&v, t] {
+                    for (size_t i = 0; i < per_writer; ++i) {
+                        if (i % 2 == 0) {
+                            v.PushBack(t * per_writer + i);
+                        }
+                        else {
+                            assert(v.EmplaceBack(t * per_writer + i) == t * per_writer + i);
+                        }
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            done = true;
+            reader.join();
+
+            assert(v.GetSize() == writers * per_writer);
+            std::vector<bool> seen(writers * per_writer);
+            for (size_t i = 0; i < v.GetSize(); ++i) {
+                const size_t value = v.At(i);
+                assert(!seen[value]);
+                seen[value] = true;
+            }
+            assert(!v.IsPublished(v.GetSize()));
+            try {
+                v.At(v.GetSize());
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+        }
+        {
+            ConcurrentSimpleVector<std::string> v;
+            v.Reserve(1000);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&v, t] {
+                    for (int i = 0; i < 500; ++i) {
+                        v.EmplaceBack(static_cast<size_t>(t + 1), 'a');
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            assert(v.GetSize() == 2000);
+            size_t total_length = 0;
+            for (size_t i = 0; i < v.GetSize(); ++i) {
+                total_length += v[i].size();
+            }
+            assert(total_length == 500 * (1 + 2 + 3 + 4));
+        }
+        {
+            ConcurrentSimpleVector<detail::Counted> v;
+            for (int i = 0; i < 100; ++i) {
+                v.EmplaceBack(i);
+            }
+            assert(detail::Counted::alive == 100);
+            v.Clear();
+            assert(v.IsEmpty() && detail::Counted::alive == 0);
+            v.EmplaceBack(1);
+            assert(v[0].GetValue() == 1);
+        }
+        assert(detail::Counted::alive == 0);
+        {
+            detail::CountingResource resource;
+            {
+                ConcurrentSimpleVector<std::string, std::pmr::polymorphic_allocator<std::string>> v(&resource);
+                v.PushBack("a long string that does not fit into the small buffer"s);
+                assert(resource.GetAllocations() == 1);
+            }
+            assert(resource.GetBytesInUse() == 0);
+        }
+        {
+            // Потоки, одновременно выделившие один сегмент, освобождают проигравшие копии:
+            // после добавления занято столько же памяти, сколько при последовательном заполнении
+            detail::CountingResource resource;
+            detail::CountingResource sequential_resource;
+            {
+                using Vector = ConcurrentSimpleVector<size_t, std::pmr::polymorphic_allocator<size_t>, 2>;
+                Vector v(&resource);
+                std::vector<std::thread> threads;
+                for (size_t t = 0; t < writers; ++t) {
+                    threads.emplace_back([&v] {
+                        for (size_t i = 0; i < 1000; ++i) {
+                            v.PushBack(i);
+                        }
+                    });
+                }
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+                Vector sequential(&sequential_resource);
+                for (size_t i = 0; i < v.GetSize(); ++i) {
+                    sequential.PushBack(i);
+                }
+                assert(resource.GetBytesInUse() == sequential_resource.GetBytesInUse());
+                assert(resource.GetAllocations() >= sequential_resource.GetAllocations());
+            }
+            assert(resource.GetBytesInUse() == 0);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void SegmentedVectorStableAddresses() {
+        using namespace std::string_literals;
+        std::cout << "Test segmented vector"s << std::endl;
+        {
+            SegmentedVector<int, MallocAllocator<int>, 4> v;
+            assert(v.IsEmpty() && v.GetCapacity() == 0);
+            v.PushBack(0);
+            const int* const first = &v[0];
+            for (int i = 1; i < 1000; ++i) {
+                v.PushBack(i);
+                // Рост не перемещает ранее добавленные элементы
+                assert(&v[0] == first);
+            }
+            assert(v.GetSize() == 1000);
+            assert(v.GetCapacity() >= 1000);
+            for (int i = 0; i < 1000; ++i) {
+                assert(v[i] == i && v.At(i) == i);
+            }
+            try {
+                v.At(1000);
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+
+            // Итераторы произвольного доступа работают со стандартными алгоритмами
+            assert(std::accumulate(v.begin(), v.end(), 0) == 999 * 1000 / 2);
+            assert(v.end() - v.begin() == 1000);
+            assert(*(v.begin() + 500) == 500 && v.begin()[7] == 7);
+            assert(std::lower_bound(v.cbegin(), v.cend(), 321) - v.cbegin() == 321);
+            SegmentedVector<int, MallocAllocator<int>, 4>::ConstIterator it = v.begin();
+            assert(it == v.cbegin());
+            std::reverse(v.begin(), v.end());
+            assert(v[0] == 999 && v[999] == 0);
+
+            const size_t capacity = v.GetCapacity();
+            while (v.GetSize() > 10) {
+                v.PopBack();
+            }
+            assert(v.GetCapacity() == capacity);
+            assert(v.GetSize() == 10 && v[9] == 990);
+        }
+        {
+            // Ссылка на собственный элемент остается действительной при росте
+            SegmentedVector<std::string, MallocAllocator<std::string>, 1> v{ "a long string that does not fit into SSO"s };
+            for (int i = 0; i < 20; ++i) {
+                v.PushBack(v[0]);
+            }
+            assert(v.GetSize() == 21 && v[20] == v[0]);
+
+            SegmentedVector<std::string, MallocAllocator<std::string>, 1> copy(v);
+            assert(copy == v);
+            copy.PushBack("b"s);
+            assert(v < copy && copy != v);
+
+            SegmentedVector<std::string, MallocAllocator<std::string>, 1> moved(std::move(copy));
+            assert(copy.IsEmpty() && moved.GetSize() == 22);
+            copy = moved;
+            assert(copy == moved);
+            moved = std::move(copy);
+            assert(moved.GetSize() == 22);
+        }
+        {
+            SegmentedVector<detail::Counted> v;
+            v.Reserve(100);
+            assert(v.GetCapacity() >= 100 && detail::Counted::alive == 0);
+            for (int i = 0; i < 300; ++i) {
+                v.EmplaceBack(i);
+            }
+            assert(detail::Counted::alive == 300);
+            v.Clear();
+            assert(detail::Counted::alive == 0 && v.IsEmpty());
+            v.EmplaceBack(1);
+        }
+        assert(detail::Counted::alive == 0);
+        {
+            detail::CountingResource resource;
+            {
+                SegmentedVector<int, std::pmr::polymorphic_allocator<int>, 8> v(&resource);
+                for (int i = 0; i < 100; ++i) {
+                    v.PushBack(i);
+                }
+                // Сегменты по 8, 16, 32 и 64 элемента
+                assert(resource.GetAllocations() == 4);
+            }
+            assert(resource.GetBytesInUse() == 0);
+        }
+        {
+            // polymorphic_allocator не распространяется при присваивании и обмене: при разных ресурсах
+            // элементы копируются и перемещаются в сегменты ресурса вектора, которому присваивают
+            using PmrSegmented = SegmentedVector<std::string, std::pmr::polymorphic_allocator<std::string>, 8>;
+            detail::CountingResource left_resource;
+            detail::CountingResource right_resource;
+            {
+                PmrSegmented left(&left_resource);
+                left.PushBack("old"s);
+                PmrSegmented right(&right_resource);
+                for (int i = 0; i < 20; ++i) {
+                    right.PushBack(std::to_string(i));
+                }
+
+                left = right;
+                assert(left == right && left.GetAllocator().resource() == &left_resource);
+                const size_t right_bytes = right_resource.GetBytesInUse();
+
+                left.PushBack("tail"s);
+                left = std::move(right);
+                assert(left.GetSize() == 20 && left[19] == "19"s && right.IsEmpty());
+                assert(left.GetAllocator().resource() == &left_resource);
+                assert(right_resource.GetBytesInUse() == right_bytes);
+
+                // Копия со своим ресурсом
+                const PmrSegmented copy(left, &right_resource);
+                assert(copy == left && copy.GetAllocator().resource() == &right_resource);
+            }
+            assert(left_resource.GetBytesInUse() == 0 && right_resource.GetBytesInUse() == 0);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void CopyOnWrite() {
+        using namespace std::string_literals;
+        std::cout << "Test copy on write"s << std::endl;
+        {
+            CowSimpleVector<int> original{ 1, 2, 3 };
+            assert(!original.IsShared());
+
+            // Копия разделяет буфер с оригиналом
+            CowSimpleVector<int> snapshot = original;
+            assert(original.IsShared() && snapshot.IsShared());
+            assert(snapshot.cbegin() == original.cbegin());
+            assert(snapshot == original);
+
+            // Константный доступ не отделяет вектор
+            const CowSimpleVector<int>& view = snapshot;
+            assert(view[1] == 2 && view.At(2) == 3 && view.GetSize() == 3);
+            assert(snapshot.IsShared());
+
+            // Первое изменение копирует буфер, другие копии не меняются
+            original.PushBack(4);
+            assert(!original.IsShared() && !snapshot.IsShared());
+            assert((snapshot == CowSimpleVector<int>{ 1, 2, 3 }));
+            assert((original == CowSimpleVector<int>{ 1, 2, 3, 4 }));
+
+            // Итератор общего буфера допустим как позиция для изменения
+            CowSimpleVector<int> copy = original;
+            copy.Erase(copy.cbegin() + 1);
+            copy.Insert(copy.cbegin(), 0);
+            assert((copy == CowSimpleVector<int>{ 0, 1, 3, 4 }));
+            assert((original == CowSimpleVector<int>{ 1, 2, 3, 4 }));
+
+            copy = original;
+            copy[0] = 10;
+            assert(original[0] == 1 && copy[0] == 10);
+            assert(original < copy);
+
+            // Принудительное отделение
+            CowSimpleVector<int> detached = original;
+            const int* shared_begin = original.cbegin();
+            detached.Detach();
+            assert(!detached.IsShared() && detached.cbegin() != shared_begin);
+            const int* own_begin = detached.cbegin();
+            detached[0] = 5;
+            assert(detached.cbegin() == own_begin);
+
+            // Очистка разделяемого вектора не копирует буфер
+            CowSimpleVector<int> cleared = original;
+            cleared.Clear();
+            assert(cleared.IsEmpty() && original.GetSize() == 4 && !original.IsShared());
+        }
+        {
+            // После выдачи изменяемой ссылки буфер не разделяется: запись по старой ссылке
+            // или итератору не меняет копию, сделанную позже
+            CowSimpleVector<int> owner{ 1, 2, 3 };
+            int& first = owner[0];
+            const auto it = owner.begin() + 1;
+            CowSimpleVector<int> later_copy = owner;
+            assert(!owner.IsShared() && !later_copy.IsShared());
+            first = 10;
+            *it = 20;
+            assert((later_copy == CowSimpleVector<int>{ 1, 2, 3 }));
+            assert((owner == CowSimpleVector<int>{ 10, 20, 3 }));
+
+            CowSimpleVector<int> assigned;
+            assigned = owner;
+            first = 11;
+            assert(assigned[0] == 10 && owner[0] == 11);
+
+            // Копия, не выдававшая ссылок, снова разделяется, а очищенный вектор становится разделяемым
+            CowSimpleVector<int> shared_copy = later_copy;
+            assert(later_copy.IsShared() && shared_copy.IsShared());
+            owner.Clear();
+            owner.PushBack(1);
+            CowSimpleVector<int> owner_copy = owner;
+            assert(owner.IsShared() && owner_copy.IsShared());
+        }
+        {
+            CowSimpleVector<std::string> empty;
+            assert(empty.IsEmpty() && empty.begin() == empty.end());
+            CowSimpleVector<std::string> words(SimpleVector<std::string>{ "a"s, "b"s });
+            CowSimpleVector<std::string> other = words;
+            other.Resize(3);
+            other.EmplaceBack(2, 'c');
+            assert(other.GetSize() == 4 && other[3] == "cc"s && words.GetSize() == 2);
+            try {
+                words.At(2);
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+        }
+        {
+            // Счетчик ссылок потокобезопасен: потоки читают, копируют и изменяют свои копии
+            const CowSimpleVector<int> shared(1000, 1);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&shared, t] {
+                    for (int i = 0; i < 100; ++i) {
+                        CowSimpleVector<int> local = shared;
+                        assert(std::accumulate(local.cbegin(), local.cend(), 0) == 1000);
+                        if (i % 10 == t) {
+                            local[0] = 2;
+                            assert(local[0] == 2);
+                        }
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            assert(!shared.IsShared());
+            assert(shared[0] == 1);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void MappedFile() {
+        using namespace std::string_literals;
+        std::cout << "Test mapped file"s << std::endl;
+        const std::string path = (std::filesystem::temp_directory_path() / "simple_vector_mapped_test.bin").string();
+        const std::string bad_path = path + ".bad"s;
+        using Triple = std::array<uint32_t, 3>;
+        {
+            SimpleVector<Triple> records;
+            for (uint32_t i = 0; i < 1000; ++i) {
+                records.PushBack({ i, i * 2, i * 3 });
+            }
+            SaveToFile(records, path);
+            assert(std::filesystem::file_size(path) == kMappedDataOffset + 1000 * sizeof(Triple));
+
+            // Элементы читаются из отображения без копирования
+            const MappedSimpleVector<Triple> mapped(path);
+            assert(!mapped.IsWritable() && mapped.GetSize() == 1000 && mapped.GetCapacity() == 1000);
+            assert(std::equal(mapped.begin(), mapped.end(), records.begin(), records.end()));
+            assert(mapped[999][0] == 999 && mapped.At(10)[2] == 30);
+            try {
+                mapped.At(1000);
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+
+            // Отображение только для чтения не допускает изменений и у неконстантного объекта:
+            // обход, доступ по индексу и представление дают только константные элементы
+            MappedSimpleVector<Triple> read_only(path);
+            static_assert(std::is_same_v<decltype(read_only.begin()), const Triple*>);
+            static_assert(std::is_same_v<decltype(read_only[0]), const Triple&>);
+            static_assert(!std::is_constructible_v<SimpleVectorView<Triple>, MappedSimpleVector<Triple>&>);
+            uint32_t sum = 0;
+            for (const Triple& triple : read_only) {
+                sum += triple[0];
+            }
+            assert(sum == 999 * 1000 / 2 && read_only[0][1] == 0 && read_only[999][2] == 2997);
+            const SimpleVectorView<const Triple> view = read_only;
+            assert(view.GetSize() == 1000 && view.Data() == read_only.begin());
+            assert(read_only == mapped);
+        }
+        {
+            // Размер элемента проверяется при открытии
+            try {
+                MappedSimpleVector<uint64_t> wrong_type(path);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+
+            // Файл чужого формата и обрезанный файл отвергаются
+            std::filesystem::copy_file(path, bad_path, std::filesystem::copy_options::overwrite_existing);
+            std::filesystem::resize_file(bad_path, kMappedDataOffset + 10);
+            try {
+                MappedSimpleVector<Triple> truncated(bad_path);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            std::filesystem::resize_file(bad_path, 0);
+            std::filesystem::resize_file(bad_path, 4096);
+            try {
+                MappedSimpleVector<Triple> garbage(bad_path);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            std::filesystem::remove(bad_path);
+        }
+        {
+            // Запись через отображение: Reserve и рост при PushBack увеличивают файл
+            std::filesystem::remove(path);
+            {
+                MappedSimpleVector<int, MappedMode::kReadWrite> writable(path);
+                assert(writable.IsWritable() && writable.IsEmpty());
+                writable.Reserve(100);
+                assert(writable.GetCapacity() == 100);
+                assert(std::filesystem::file_size(path) == kMappedDataOffset + 100 * sizeof(int));
+                for (int i = 0; i < 10'000; ++i) {
+                    writable.PushBack(i);
+                }
+                writable.PushBack(writable[0]);
+                writable[1] = -1;
+                writable.PopBack();
+                assert(writable.GetSize() == 10'000 && writable.GetCapacity() >= 10'000);
+                assert(std::filesystem::file_size(path) == kMappedDataOffset + writable.GetCapacity() * sizeof(int));
+                writable.Flush();
+            }
+            {
+                MappedSimpleVector<int, MappedMode::kReadWrite> reopened(path);
+                assert(reopened.GetSize() == 10'000 && reopened[1] == -1 && reopened[9'999] == 9'999);
+                reopened.Resize(10'002);
+                assert(reopened[10'001] == 0);
+                MappedSimpleVector<int, MappedMode::kReadWrite> moved(std::move(reopened));
+                assert(moved.GetSize() == 10'002 && reopened.GetSize() == 0);
+            }
+            const MappedSimpleVector<int> mapped(path);
+            assert(mapped.GetSize() == 10'002 && mapped[2] == 2);
+            std::filesystem::remove(path);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void Serialization() {
+        using namespace std::string_literals;
+        std::cout << "Test serialization"s << std::endl;
+        {
+            // Тривиально копируемые элементы с контрольной суммой и без нее
+            SimpleVector<int> numbers;
+            for (int i = 0; i < 1'000'000; ++i) {
+                numbers.PushBack(i * 7);
+            }
+            for (const bool checksum : { false, true }) {
+                std::stringstream stream;
+                Serialize(stream, numbers, { checksum });
+                assert(stream.str().size() == sizeof(StreamHeader) + numbers.GetSize() * sizeof(int) + (checksum ? 8 : 0));
+                SimpleVector<int> restored{ 1, 2, 3 };
+                Deserialize(stream, restored);
+                assert(restored == numbers);
+                assert(restored.GetCapacity() == numbers.GetSize());
+            }
+        }
+        {
+            // Несколько векторов подряд в одном потоке, включая пустой
+            SimpleVector<std::string> words{ "alpha"s, ""s, std::string(100'000, 'x') };
+            SimpleVector<double> empty;
+            SimpleVector<detail::Record24> records(3);
+            records[1].bytes[5] = 'r';
+            std::stringstream stream;
+            Serialize(stream, words, { true });
+            Serialize(stream, empty);
+            Serialize(stream, records);
+            SimpleVector<std::string> restored_words;
+            SimpleVector<double> restored_empty{ 1.0 };
+            SimpleVector<detail::Record24> restored_records;
+            Deserialize(stream, restored_words);
+            Deserialize(stream, restored_empty);
+            Deserialize(stream, restored_records);
+            assert(restored_words == words);
+            assert(restored_empty.IsEmpty());
+            assert(restored_records.GetSize() == 3 && restored_records[1].bytes[5] == 'r');
+            assert(stream.peek() == std::char_traits<char>::eof());
+        }
+        {
+            // Остаток потока узнается без сдвига позиции чтения, а поток без позиционирования
+            // сообщает только уже доступные байты и все равно читается целиком
+            SimpleVector<int> numbers{ 1, 2, 3 };
+            std::stringstream stream;
+            Serialize(stream, numbers);
+            const std::string bytes = stream.str();
+            BinaryReader reader(stream);
+            reader.Read<StreamHeader>();
+            assert(reader.GetRemainingBytes() == 3 * sizeof(int));
+            assert(reader.Read<int>() == 1 && reader.GetRemainingBytes() == 2 * sizeof(int));
+
+            detail::UnseekableBuffer buffer(bytes);
+            std::istream unseekable(&buffer);
+            assert(BinaryReader(unseekable).GetRemainingBytes() == 0);
+            SimpleVector<int> restored;
+            Deserialize(unseekable, restored);
+            assert(restored == numbers);
+        }
+        {
+            // Данные больше предела предварительного резервирования: строковый поток подтверждает, что они
+            // есть целиком, поэтому память выделяется один раз ровно под все элементы
+            SimpleVector<uint64_t> large;
+            large.Resize((64 << 20) / sizeof(uint64_t) + 1000);
+            std::iota(large.begin(), large.end(), uint64_t{ 0 });
+            std::stringstream stream;
+            Serialize(stream, large);
+            SimpleVector<uint64_t> restored;
+            Deserialize(stream, restored);
+            assert(restored.GetCapacity() == large.GetSize());
+            assert(restored == large);
+        }
+        {
+            // Пользовательский тип через SerializeTraits
+            SimpleVector<detail::X> items;
+            for (size_t i = 0; i < 100; ++i) {
+                items.PushBack(detail::X(i));
+            }
+            std::stringstream stream;
+            Serialize(stream, items);
+            SimpleVector<detail::X> restored;
+            Deserialize(stream, restored);
+            assert(restored.GetSize() == 100 && restored[42].GetX() == 42);
+        }
+        {
+            SimpleVector<int> numbers{ 1, 2, 3, 4, 5 };
+            std::stringstream stream;
+            Serialize(stream, numbers, { true });
+            const std::string bytes = stream.str();
+            SimpleVector<int> restored;
+
+            // Испорченные данные обнаруживаются по контрольной сумме
+            std::string corrupted = bytes;
+            corrupted[sizeof(StreamHeader) + 1] ^= 1;
+            std::stringstream corrupted_stream(corrupted);
+            try {
+                Deserialize(corrupted_stream, restored);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+
+            // Обрыв потока
+            std::stringstream truncated(bytes.substr(0, bytes.size() - 12));
+            try {
+                Deserialize(truncated, restored);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+
+            // Несовпадение типа элементов
+            std::stringstream wrong_type(bytes);
+            SimpleVector<int64_t> wide;
+            try {
+                Deserialize(wrong_type, wide);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+        }
+        {
+            // Поврежденные количества элементов и символов не приводят к огромному выделению памяти:
+            // память растет по мере чтения, и обрыв потока обнаруживается сразу
+            const uint64_t huge = uint64_t{ 1 } << 60;
+            SimpleVector<int> numbers{ 1, 2, 3 };
+            std::stringstream stream;
+            Serialize(stream, numbers);
+            std::string corrupted = stream.str();
+            std::memcpy(corrupted.data() + offsetof(StreamHeader, count), &huge, sizeof(huge));
+            std::stringstream corrupted_stream(corrupted);
+            SimpleVector<int> restored;
+            try {
+                Deserialize(corrupted_stream, restored);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(restored.GetCapacity() * sizeof(int) <= (64 << 20));
+
+            SimpleVector<std::string> words{ "alpha"s };
+            std::stringstream words_stream;
+            Serialize(words_stream, words);
+            std::string corrupted_words = words_stream.str();
+            std::memcpy(corrupted_words.data() + sizeof(StreamHeader), &huge, sizeof(huge));
+            std::stringstream corrupted_words_stream(corrupted_words);
+            SimpleVector<std::string> restored_words;
+            try {
+                Deserialize(corrupted_words_stream, restored_words);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void View() {
+        using namespace std::string_literals;
+        std::cout << "Test view"s << std::endl;
+        {
+            SimpleVector<int> v{ 1, 2, 3, 4, 5 };
+
+            // Вектор неявно приводится к представлению без копирования
+            assert(detail::Sum(v) == 15);
+            SimpleVectorView<int> all = v;
+            assert(all.Data() == v.begin() && all.GetSize() == 5);
+
+            // Литерал 0 выбирает конструктор с размером, а не с концом диапазона
+            SimpleVectorView<int> empty(v.begin(), 0);
+            assert(empty.Data() == v.begin() && empty.IsEmpty());
+            SimpleVectorView<const int> pair_range(v.begin() + 1, v.begin() + 3);
+            assert(pair_range.GetSize() == 2 && pair_range[0] == 2);
+            const SimpleVectorView deduced(v.begin(), 0);
+            static_assert(std::is_same_v<decltype(deduced), const SimpleVectorView<int>>);
+
+            // Подпредставления и доступ к элементам
+            SimpleVectorView<int> middle = all.Subview(1, 3);
+            assert(middle.GetSize() == 3 && middle[0] == 2 && middle.At(2) == 4);
+            assert(detail::Sum(middle) == 9);
+            assert(all.Subview(3).GetSize() == 2 && all.Subview(5).IsEmpty());
+            assert(all.Subview(4, 100).GetSize() == 1);
+            try {
+                all.Subview(6);
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+            try {
+                middle.At(3);
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+
+            // Изменяемое представление пишет в вектор
+            middle[1] = 30;
+            for (int& item : middle.Subview(2)) {
+                item *= 10;
+            }
+            assert((v == SimpleVector<int>{ 1, 2, 30, 40, 5 }));
+
+            // Построение по указателю с размером и по паре итераторов, выведение типа
+            SimpleVectorView pointer_view(v.begin() + 1, size_t{ 2 });
+            static_assert(std::is_same_v<decltype(pointer_view), SimpleVectorView<int>>);
+            const SimpleVector<int>& cv = v;
+            SimpleVectorView const_view(cv);
+            static_assert(std::is_same_v<decltype(const_view), SimpleVectorView<const int>>);
+            SimpleVectorView<const int> range(cv.begin() + 1, cv.begin() + 3);
+            assert(range == pointer_view);
+            static_assert(!std::is_constructible_v<SimpleVectorView<int>, const SimpleVector<int>&>);
+            static_assert(!std::is_constructible_v<SimpleVectorView<int>, SimpleVector<int>&&>);
+            static_assert(std::is_convertible_v<SimpleVectorView<int>, SimpleVectorView<const int>>);
+            static_assert(!std::is_convertible_v<SimpleVectorView<const int>, SimpleVectorView<int>>);
+
+            // Сравнения представлений друг с другом и с векторами
+            assert(const_view == v && v == const_view && const_view == all);
+            assert(range < const_view.Subview(2));
+            assert(const_view.Subview(0, 2) < range);
+            assert(const_view.Subview(0, 2) <= const_view);
+            assert(const_view > const_view.Subview(0, 4));
+            assert(SimpleVectorView<const int>() == SimpleVector<int>());
+            assert((const_view != SimpleVector<int>{ 1, 2 }));
+        }
+        {
+            // Представления других непрерывных векторов и нетривиальных типов
+            SmallSimpleVector<std::string, 4> small{ "a"s, "b"s, "c"s };
+            SimpleVectorView<std::string> words = small;
+            words[0] = "z"s;
+            assert(small[0] == "z"s);
+            SimpleVectorView<const std::string> tail = words.Subview(1);
+            assert((tail == SimpleVector<std::string>{ "b"s, "c"s }));
+            assert(tail < words);
+
+            SimpleVector<double> values{ 1.0, 2.0, std::numeric_limits<double>::quiet_NaN() };
+            SimpleVectorView<const double> doubles = values;
+            assert(doubles.Subview(0, 2) == SimpleVectorView(values).Subview(0, 2));
+            assert(doubles != values);
+        }
+        {
+            // Представление только для чтения не отделяет CowSimpleVector от других копий
+            CowSimpleVector<int> original{ 1, 2, 3 };
+            CowSimpleVector<int> copy = original;
+            const int* shared_begin = copy.cbegin();
+            SimpleVectorView<const int> view = original;
+            assert(original.IsShared() && copy.IsShared());
+            assert(view.Data() == shared_begin && original.cbegin() == shared_begin);
+            assert(detail::Sum(original) == 6);
+            assert(original.IsShared());
+
+            // Исходный вектор по-прежнему разделяет данные с новыми копиями
+            CowSimpleVector<int> later_copy = original;
+            assert(later_copy.cbegin() == shared_begin);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void StructureOfArrays() {
+        using namespace std::string_literals;
+        std::cout << "Test structure of arrays"s << std::endl;
+        {
+            SoaVector<int, double, std::string> v;
+            assert(v.IsEmpty() && v.begin() == v.end());
+            for (int i = 0; i < 100; ++i) {
+                v.PushBack(i, i * 0.5, std::to_string(i));
+            }
+            assert(v.GetSize() == 100 && v.GetCapacity() >= 100);
+
+            // Строка доступна как кортеж ссылок
+            auto [id, score, name] = v[10];
+            assert(id == 10 && score == 5.0 && name == "10"s);
+            name = "ten"s;
+            std::get<0>(v.At(11)) = -11;
+            assert(std::get<2>(v[10]) == "ten"s && std::get<0>(v[11]) == -11);
+            try {
+                v.At(100);
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+
+            // Столбцы непрерывны
+            SimpleVectorView<int> ids = v.GetColumn<0>();
+            assert(ids.GetSize() == 100 && &ids[5] + 1 == &ids[6]);
+            const auto& cv = v;
+            SimpleVectorView<const double> scores = cv.GetColumn<1>();
+            assert(std::accumulate(scores.begin(), scores.end(), 0.0) == 2475.0);
+
+            // Итераторы строк
+            int rows = 0;
+            for (auto [row_id, row_score, row_name] : cv) {
+                assert(row_score == (rows) * 0.5);
+                (void)row_id;
+                (void)row_name;
+                ++rows;
+            }
+            assert(rows == 100 && cv.end() - cv.begin() == 100);
+            SoaVector<int, double, std::string>::ConstIterator it = v.begin() + 3;
+            assert(std::get<0>(*it) == 3 && std::get<0>(it[2]) == 5);
+
+            // Удаление сдвигает все столбцы
+            auto next = v.Erase(v.cbegin());
+            assert(next == v.begin() && std::get<0>(*next) == 1);
+            v.Erase(v.cbegin() + 9, v.cbegin() + 19);
+            assert(v.GetSize() == 89);
+            assert(std::get<0>(v[9]) == 20 && std::get<2>(v[9]) == "20"s && std::get<1>(v[9]) == 10.0);
+            assert(std::get<2>(v[8]) == "9"s);
+
+            // Копирование, перемещение и сравнение
+            SoaVector<int, double, std::string> copy = v;
+            assert(copy == v);
+            std::get<2>(copy[0]) = "changed"s;
+            assert(copy != v);
+            SoaVector<int, double, std::string> moved = std::move(copy);
+            assert(copy.IsEmpty() && moved.GetSize() == 89);
+            copy = moved;
+            assert(copy == moved);
+
+            // Изменение размера и вместимости
+            v.Resize(200);
+            assert(v.GetSize() == 200 && std::get<0>(v[199]) == 0 && std::get<2>(v[199]).empty());
+            v.Resize(5);
+            v.Reserve(1000);
+            assert(v.GetSize() == 5 && v.GetCapacity() == 1000 && std::get<0>(v[4]) == 5);
+            v.PopBack();
+            v.Clear();
+            assert(v.IsEmpty() && v.GetCapacity() == 1000);
+        }
+        {
+            // Элементы разрушаются при удалении, очистке и разрушении вектора
+            using detail::Counted;
+            {
+                SoaVector<Counted, int> v;
+                for (int i = 0; i < 50; ++i) {
+                    v.PushBack(Counted(i), i);
+                }
+                assert(Counted::alive == 50);
+                v.Erase(v.cbegin() + 10, v.cbegin() + 20);
+                assert(Counted::alive == 40 && std::get<0>(v[10]).GetValue() == 20);
+                v.PopBack();
+                assert(Counted::alive == 39);
+                SoaVector<Counted, int> copy = v;
+                assert(Counted::alive == 78);
+            }
+            assert(Counted::alive == 0);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void AlignedStorage() {
+        using namespace std::string_literals;
+        std::cout << "Test aligned storage"s << std::endl;
+        {
+            // Вместимость дополняется до кратной ширине блока
+            assert((PaddedGrowth<32>::NextCapacity(0, 1, sizeof(float)) == 8));
+            assert((PaddedGrowth<32>::NextCapacity(8, 9, sizeof(float)) == 16));
+            assert((PaddedGrowth<64>::NextCapacity(0, 1, sizeof(double)) == 8));
+            assert((PaddedGrowth<64>::NextCapacity(0, 1, 24) == 2));
+            assert((PaddedGrowth<32, OneAndHalfGrowth>::NextCapacity(8, 9, sizeof(float)) == 16));
+        }
+        {
+            AlignedSimpleVector<float, 32> v;
+            assert(v.IsAligned());
+            for (int i = 0; i < 1000; ++i) {
+                v.PushBack(static_cast<float>(i));
+                assert(v.IsAligned() && v.IsAligned(32));
+                assert(v.GetCapacity() * sizeof(float) % 32 == 0);
+            }
+            float* data = v.AlignedData();
+            assert(data == v.begin() && data[999] == 999.0f);
+            v.Insert(v.begin() + 1, -1.0f);
+            v.Erase(v.begin() + 1);
+            assert(v.IsAligned() && v[1] == 1.0f);
+
+            const AlignedSimpleVector<float, 32> copy = v;
+            assert(copy.IsAligned() && copy == v);
+            assert(copy.AlignedData<16>() == copy.begin());
+
+            // Выравнивание по странице
+            AlignedSimpleVector<char, 4096> page(10, 'x');
+            assert(page.IsAligned(4096) && page[9] == 'x');
+            page.Resize(5000);
+            assert(page.IsAligned(4096));
+        }
+        {
+            // Нетривиальные элементы переносятся в новый выровненный блок
+            AlignedSimpleVector<std::string> words;
+            for (int i = 0; i < 100; ++i) {
+                words.PushBack(std::to_string(i));
+                assert(words.IsAligned(64));
+            }
+            assert(words[42] == "42"s);
+
+            // Выравнивание по умолчанию равно alignof элемента
+            SimpleVector<double> plain(3);
+            assert(plain.IsAligned() && plain.AlignedData() == plain.begin());
+            static_assert(::detail::kAllocatorAlignment<MallocAllocator<double>> == alignof(double));
+            static_assert(::detail::kAllocatorAlignment<AlignedAllocator<double, 64>> == 64);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void Instrumentation() {
+        using namespace std::string_literals;
+        using detail::Probe;
+        std::cout << "Test instrumentation"s << std::endl;
+        ResetVectorStats();
+        SetVectorSink(detail::CountSinkEvent);
+        {
+            SimpleVector<Probe> v;
+            v.Reserve(4);
+            for (int i = 0; i < 5; ++i) {
+                v.PushBack({ i });
+            }
+            v.Insert(v.begin(), { -1 });
+            v.Erase(v.begin());
+            v.Erase(v.begin(), v.begin() + 2);
+            {
+                ScopedVectorTag tag("parser");
+                SimpleVector<Probe> tagged(10);
+                {
+                    ScopedVectorTag inner("inner");
+                    tagged.Resize(100);
+                }
+                tagged.Insert(tagged.begin() + 90, { 0 });
+            }
+        }
+        SetVectorSink(nullptr);
+
+        const VectorStats stats = GetVectorStats<Probe>();
+        const VectorStats parser = GetVectorTagStats("parser"s);
+        const VectorStats inner = GetVectorTagStats("inner"s);
+        if constexpr (kVectorInstrumentation) {
+            // Reserve, рост до 8, создание tagged, рост до 100 и до 200
+            assert(stats.allocations == 5);
+            assert(stats.allocated_bytes == (4 + 8 + 10 + 100 + 200) * sizeof(Probe));
+            // Рост с 4 до 8 элементов, с 10 до 100 и со 100 до 200
+            assert(stats.relocations == 3 && stats.relocated_elements == 4 + 10 + 100);
+            assert(stats.insert_shifted_elements == 5 + 10);
+            assert(stats.erase_shifted_elements == 5 + 3);
+
+            assert(parser.allocations == 2 && parser.relocations == 1 && parser.relocated_elements == 100);
+            assert(parser.insert_shifted_elements == 10);
+            assert(inner.allocations == 1 && inner.relocated_elements == 10);
+            assert(detail::sink_events == 5 + 3 + 2 + 2);
+
+            bool found = false;
+            VisitVectorTypeStats([&found](const char* name, const VectorStats& type_stats) {
+                if (name == std::string(typeid(Probe).name())) {
+                    found = type_stats.allocations == 5;
+                }
+            });
+            assert(found);
+            size_t tags = 0;
+            VisitVectorTagStats([&tags](const std::string&, const VectorStats&) {
+                ++tags;
+            });
+            assert(tags == 2);
+
+            ResetVectorStats();
+            assert(GetVectorStats<Probe>().allocations == 0 && GetVectorTagStats("parser"s).allocations == 0);
+        }
+        else {
+            // Без SIMPLE_VECTOR_INSTRUMENTATION события не учитываются
+            assert(stats.allocations == 0 && stats.relocations == 0 && stats.insert_shifted_elements == 0);
+            assert(parser.allocations == 0 && inner.allocations == 0 && detail::sink_events == 0);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void OverwriteGrowth() {
+        using namespace std::string_literals;
+        std::cout << "Test overwrite growth"s << std::endl;
+        {
+            SimpleVector<char> buffer(3, 'a');
+            buffer.ResizeForOverwrite(10);
+            assert(buffer.GetSize() == 10 && buffer.GetCapacity() >= 10);
+            assert(buffer[0] == 'a' && buffer[2] == 'a');
+            std::fill(buffer.begin() + 3, buffer.end(), 'b');
+            buffer.ResizeForOverwrite(4);
+            assert(buffer.GetSize() == 4 && buffer[3] == 'b');
+            const char* const data = buffer.begin();
+            buffer.ResizeForOverwrite(buffer.GetCapacity());
+            assert(buffer.begin() == data);
+        }
+        {
+            // Нетривиальные элементы создаются конструктором по умолчанию
+            SimpleVector<detail::X> v;
+            v.PushBack(detail::X(1));
+            v.ResizeForOverwrite(3);
+            assert(v.GetSize() == 3 && v[0].GetX() == 1 && v[1].GetX() == 5 && v[2].GetX() == 5);
+        }
+        {
+            const std::string source = "The quick brown fox jumps over the lazy dog"s;
+            std::istringstream in(source);
+            SimpleVector<char> buffer;
+            size_t appended = 0;
+            do {
+                appended = buffer.ReserveAndAppend(8, [&in](char* tail, size_t max_count) {
+                    in.read(tail, static_cast<std::streamsize>(max_count));
+                    return static_cast<size_t>(in.gcount());
+                });
+            } while (appended == 8);
+            assert(buffer.GetSize() == source.size());
+            assert(std::equal(buffer.begin(), buffer.end(), source.begin(), source.end()));
+            // Вместимость растет согласно политике роста, а не ровно на запрошенное место
+            assert(buffer.GetCapacity() == 64);
+        }
+        {
+            SimpleVector<uint32_t> v{ 1, 2 };
+            v.Reserve(10);
+            const uint32_t* const data = v.begin();
+            const size_t written = v.ReserveAndAppend(8, [](uint32_t* tail, size_t max_count) {
+                assert(max_count == 8);
+                std::iota(tail, tail + 3, 3u);
+                return size_t{ 3 };
+            });
+            assert(written == 3 && v.begin() == data);
+            assert((v == SimpleVector<uint32_t>{ 1, 2, 3, 4, 5 }));
+
+            assert(v.ReserveAndAppend(0, [](uint32_t*, size_t) {
+                return size_t{ 0 };
+            }) == 0);
+            assert(v.GetSize() == 5);
+
+            // Если writer выбрасывает исключение, размер не изменяется
+            bool thrown = false;
+            try {
+                v.ReserveAndAppend(100, [](uint32_t* tail, size_t) -> size_t {
+                    tail[0] = 42;
+                    throw std::runtime_error("read failed");
+                });
+            }
+            catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            assert(thrown && v.GetSize() == 5 && v.GetCapacity() >= 105);
+            assert((v == SimpleVector<uint32_t>{ 1, 2, 3, 4, 5 }));
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void SortedContainers() {
+        using namespace std::string_literals;
+        std::cout << "Test sorted containers"s << std::endl;
+        {
+            // Поиск без ветвлений совпадает с std::lower_bound и std::upper_bound
+            std::mt19937 generator(7);
+            for (size_t count = 0; count < 40; ++count) {
+                std::vector<int> items(count);
+                for (int& item : items) {
+                    item = static_cast<int>(generator() % 16);
+                }
+                std::sort(items.begin(), items.end());
+                for (int key = -1; key <= 16; ++key) {
+                    const int* const data = items.data();
+                    assert(::detail::BranchlessLowerBound(data, count, key, std::less<int>())
+                        == data + (std::lower_bound(items.begin(), items.end(), key) - items.begin()));
+                    assert(::detail::BranchlessUpperBound(data, count, key, std::less<int>())
+                        == data + (std::upper_bound(items.begin(), items.end(), key) - items.begin()));
+                }
+            }
+        }
+        {
+            SortedSimpleVector<int, std::less<int>, 4> v{ 5, 1, 3 };
+            assert(v.GetSize() == 3 && v.Contains(3) && !v.Contains(2));
+            for (const int value : { 2, 5, 0, 5 }) {
+                v.Insert(value);
+            }
+            // Вставки видны поиску до слияния буфера
+            assert(v.GetSize() == 7 && v.Contains(2) && v.Count(5) == 3 && v.Find(4) == nullptr);
+            v.Insert(4);
+            assert(v.Count(5) == 3 && *v.Find(4) == 4);
+            assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 0, 1, 2, 3, 4, 5, 5, 5 }));
+            assert(v[3] == 3 && v.At(7) == 5);
+            try {
+                v.At(8);
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+            assert(v.Erase(5) == 3 && v.Erase(7) == 0 && v.GetSize() == 5);
+            const std::array<int, 3> batch{ 9, -1, 3 };
+            v.Insert(batch.begin(), batch.end());
+            assert((v == SortedSimpleVector<int, std::less<int>, 4>{ -1, 0, 1, 2, 3, 3, 4, 9 }));
+        }
+        {
+            // Равные элементы сохраняют порядок вставки
+            using Item = std::pair<int, int>;
+            const auto by_first = [](const Item& lhs, const Item& rhs) {
+                return lhs.first < rhs.first;
+            };
+            SortedSimpleVector<Item, decltype(by_first), 2> v(by_first);
+            for (const Item& item : { Item{ 1, 0 }, Item{ 0, 1 }, Item{ 1, 2 }, Item{ 1, 3 }, Item{ 0, 4 } }) {
+                v.Insert(item);
+            }
+            assert((std::vector<Item>(v.begin(), v.end())
+                == std::vector<Item>{ { 0, 1 }, { 0, 4 }, { 1, 0 }, { 1, 2 }, { 1, 3 } }));
+        }
+        {
+            // Доступ по индексу и обход без слияния буфера совпадают с упорядоченным std::vector
+            std::mt19937 generator(11);
+            SortedSimpleVector<int, std::less<int>, 16> v;
+            std::vector<int> expected;
+            for (int i = 0; i < 300; ++i) {
+                const int value = static_cast<int>(generator() % 100);
+                v.Insert(value);
+                expected.insert(std::upper_bound(expected.begin(), expected.end(), value), value);
+                const size_t index = generator() % expected.size();
+                assert(v[index] == expected[index]);
+            }
+            assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+        }
+        {
+            // Если сравнение при слиянии выбросит исключение, вектор не изменяется
+            int budget = -1;
+            const auto less = [&budget](int lhs, int rhs) {
+                if (budget == 0) {
+                    throw std::runtime_error("compare failed");
+                }
+                if (budget > 0) {
+                    --budget;
+                }
+                return lhs < rhs;
+            };
+            SortedSimpleVector<int, decltype(less), 4> v({ 10, 20, 30 }, less);
+            for (const int value : { 25, 5, 15, 35 }) {
+                v.Insert(value);
+            }
+            const std::vector<int> expected{ 5, 10, 15, 20, 25, 30, 35 };
+            budget = 1;
+            try {
+                v.Insert(0);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            budget = -1;
+            assert((std::vector<int>(v.begin(), v.end()) == expected));
+
+            const std::array<int, 3> batch{ 3, 2, 1 };
+            budget = 4;
+            try {
+                v.Insert(batch.begin(), batch.end());
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            budget = -1;
+            assert((std::vector<int>(v.begin(), v.end()) == expected));
+        }
+        {
+            // Константные методы не сливают буфер, поэтому обход и поиск из нескольких потоков безопасны
+            FlatMap<int, int> map;
+            for (int i = 0; i < 1000; ++i) {
+                map.Insert(i * 7 % 1000, i);
+            }
+            const auto& shared = map;
+            std::vector<std::thread> readers;
+            for (int t = 0; t < 4; ++t) {
+                readers.emplace_back([&shared, t] {
+                    int previous = -1;
+                    for (const auto& [key, value] : shared) {
+                        assert(previous < key && value * 7 % 1000 == key);
+                        previous = key;
+                    }
+                    assert(previous == 999 && shared.Contains(t) && shared.At(7) == 1);
+                });
+            }
+            for (std::thread& reader : readers) {
+                reader.join();
+            }
+        }
+        {
+            FlatSet<std::string, std::less<>, 2> set{ "pear"s, "apple"s, "pear"s };
+            assert(set.GetSize() == 2);
+            assert(set.Insert("plum"s) && !set.Insert("apple"s) && !set.Insert("plum"s));
+            assert(set.Contains(std::string_view("plum")) && !set.Contains("fig"));
+            assert(set.Insert("fig"s) && set.Insert("kiwi"s) && set.GetSize() == 5);
+            const std::array<std::string, 3> batch{ "lime"s, "fig"s, "lime"s };
+            set.Insert(batch.begin(), batch.end());
+            assert(set.GetSize() == 6 && set.Contains("lime"));
+            assert(set.Erase("lime"));
+            // Удаление из буфера и из упорядоченной части
+            assert(set.Erase("kiwi") && set.Erase("apple") && !set.Erase("apple"));
+            assert((std::vector<std::string>(set.begin(), set.end()) == std::vector<std::string>{ "fig"s, "pear"s, "plum"s }));
+        }
+        {
+            FlatMap<int, std::string, std::less<int>, 4> map{ { 3, "c"s }, { 1, "a"s }, { 3, "x"s } };
+            assert(map.GetSize() == 2 && map.At(3) == "c"s);
+            map[2] = "b"s;
+            map[1] += "a"s;
+            assert(!map.Insert(2, "y"s) && map.Insert(0, "z"s));
+            assert(map.GetSize() == 4 && map.At(2) == "b"s && map.At(1) == "aa"s && map.Find(5) == map.end());
+
+            // Через итераторы и Find можно изменить значение, но не ключ
+            static_assert(std::is_same_v<decltype(*map.begin()), std::pair<const int&, std::string&>>);
+            static_assert(!std::is_assignable_v<decltype((map.begin()->first)), int>);
+            static_assert(!std::is_assignable_v<decltype((std::as_const(map).begin()->first)), int>);
+            const auto found = map.Find(2);
+            assert(found != map.cend() && found->first == 2);
+            found->second = "bb"s;
+            for (auto [key, value] : map) {
+                value += "!"s;
+            }
+            assert(map.At(2) == "bb!"s && std::as_const(map).Find(0)->second == "z!"s);
+            for (auto [key, value] : map) {
+                value.pop_back();
+            }
+            map.At(2) = "b"s;
+
+            try {
+                map.At(5);
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+            std::string keys;
+            for (const auto& [key, value] : map) {
+                keys += std::to_string(key) + value;
+            }
+            assert(keys == "0z1aa2b3c"s);
+            assert(map.Erase(0) && !map.Erase(0) && !map.Contains(0));
+
+            const std::array<std::pair<int, std::string>, 4> batch{ { { 5, "e"s }, { 1, "q"s }, { 4, "d"s }, { 5, "w"s } } };
+            map.Insert(batch.begin(), batch.end());
+            assert(map.GetSize() == 5 && map.At(1) == "aa"s && map.At(5) == "e"s && map.At(4) == "d"s);
+        }
+        {
+            // Случайная последовательность операций дает тот же результат, что std::map
+            std::mt19937 generator(42);
+            FlatMap<int, int, std::less<int>, 8> map;
+            std::map<int, int> expected;
+            for (int i = 0; i < 20000; ++i) {
+                const int key = static_cast<int>(generator() % 500);
+                switch (generator() % 4) {
+                case 0:
+                    assert(map.Insert(key, i) == expected.emplace(key, i).second);
+                    break;
+                case 1:
+                    map[key] += i;
+                    expected[key] += i;
+                    break;
+                case 2:
+                    assert(map.Erase(key) == (expected.erase(key) == 1));
+                    break;
+                default:
+                    assert(map.Contains(key) == (expected.count(key) == 1));
+                    break;
+                }
+                assert(map.GetSize() == expected.size());
+            }
+            assert(std::equal(map.begin(), map.end(), expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.first == rhs.first && lhs.second == rhs.second;
+            }));
+        }
+        {
+            // Значениям не нужен конструктор по умолчанию: слияние буфера создает новые ячейки перемещением
+            static_assert(!std::is_default_constructible_v<detail::Relocatable>);
+            FlatMap<int, detail::Relocatable, std::less<int>, 4> map;
+            std::vector<int> keys(100);
+            std::iota(keys.begin(), keys.end(), 0);
+            std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+            for (const int key : keys) {
+                assert(map.Insert(key, detail::Relocatable(key * 10)));
+            }
+            assert(!map.Insert(5, detail::Relocatable(0)));
+            map.Flush();
+            int expected_key = 0;
+            for (const auto& [key, value] : map) {
+                assert(key == expected_key && value.GetValue() == key * 10);
+                ++expected_key;
+            }
+            assert(expected_key == 100);
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+    void BitVectorBasics() {
+        using namespace std::string_literals;
+        std::cout << "Test bit vector"s << std::endl;
+        {
+            BitVector v;
+            assert(v.IsEmpty() && v.Count() == 0 && v.FindFirst() == BitVector::npos && v.All() && v.None());
+            for (size_t i = 0; i < 130; ++i) {
+                v.PushBack(i % 3 == 0);
+            }
+            assert(v.GetSize() == 130 && v.GetCapacity() >= 130 && v.GetWords().GetSize() == 3);
+            assert(v[0] && !v[1] && v[129] && v.Count() == 44);
+            v[1] = true;
+            v[0] = v[2];
+            v.At(63).Flip();
+            assert(!v[0] && v[1] && !v[63] && v.Count() == 43);
+            try {
+                v.At(130);
+                assert(false);
+            }
+            catch (const std::out_of_range&) {
+            }
+            assert(v.FindFirst() == 1 && v.FindNext(2) == 3 && v.FindNext(64) == 66 && v.FindNext(130) == BitVector::npos);
+            v.PopBack();
+            assert(v.GetSize() == 129 && v.Count() == 42 && v.FindNext(127) == BitVector::npos);
+        }
+        {
+            // Новые биты заполняются по словам, а биты за пределами размера остаются нулевыми
+            BitVector v(3, true);
+            v.Resize(200, true);
+            assert(v.Count() == 200 && v.All());
+            v.Resize(70);
+            assert(v.Count() == 70 && v.GetWords()[1] == 0x3F);
+            v.Resize(75, false);
+            v.Resize(140, true);
+            assert(v.Count() == 135 && !v[72] && v[75] && v[139]);
+            v.Flip();
+            assert(v.Count() == 5 && v.FindFirst() == 70 && v.GetWords()[2] == 0);
+            v.Fill(true);
+            assert(v.All() && v.GetWords()[2] == 0xFFF);
+            v.Fill(false);
+            assert(v.None());
+        }
+        {
+            BitVector v;
+            BitVector expected;
+            std::mt19937_64 generator(11);
+            for (int round = 0; round < 200; ++round) {
+                const uint64_t bits = generator();
+                const size_t count = generator() % 65;
+                v.AppendBits(bits, count);
+                for (size_t i = 0; i < count; ++i) {
+                    expected.PushBack((bits >> i) & 1);
+                }
+                assert(v == expected);
+            }
+        }
+        {
+            BitVector a(300);
+            BitVector b(300);
+            for (size_t i = 0; i < 300; ++i) {
+                a[i] = i % 2 == 0;
+                b[i] = i % 3 == 0;
+            }
+            const BitVector both = a & b;
+            const BitVector any = a | b;
+            const BitVector one = a ^ b;
+            for (size_t i = 0; i < 300; ++i) {
+                assert(both[i] == (a[i] && b[i]) && any[i] == (a[i] || b[i]) && one[i] == (a[i] != b[i]));
+            }
+            assert(both.Count() == 50 && any.Count() == 200 && one.Count() == 150);
+            assert((~a).Count() == 150 && (~a ^ a).All());
+            try {
+                a &= BitVector(299);
+                assert(false);
+            }
+            catch (const std::invalid_argument&) {
+            }
+        }
+        {
+            const BitVector v{ true, false, true, true };
+            assert(std::count(v.begin(), v.end(), true) == 3);
+            assert((std::vector<bool>(v.begin(), v.end()) == std::vector<bool>{ true, false, true, true }));
+            BitVector copy = v;
+            std::fill(copy.begin() + 1, copy.end(), false);
+            assert(copy.Count() == 1 && copy.end() - copy.begin() == 4);
+            BitVector::ConstIterator it = copy.begin();
+            assert(*it && !it[1]);
+
+            // Сравнение лексикографическое, как у SimpleVector<bool>
+            std::mt19937 generator(3);
+            for (int round = 0; round < 500; ++round) {
+                SimpleVector<bool> lhs(generator() % 140);
+                SimpleVector<bool> rhs(round % 2 == 0 ? lhs.GetSize() : generator() % 140);
+                BitVector bit_lhs;
+                BitVector bit_rhs;
+                for (size_t i = 0; i < lhs.GetSize(); ++i) {
+                    lhs[i] = generator() % 8 == 0;
+                    bit_lhs.PushBack(lhs[i]);
+                }
+                for (size_t i = 0; i < rhs.GetSize(); ++i) {
+                    rhs[i] = i < lhs.GetSize() && generator() % 16 != 0 ? lhs[i] : generator() % 2 == 0;
+                    bit_rhs.PushBack(rhs[i]);
+                }
+                assert((bit_lhs == bit_rhs) == (lhs == rhs) && (bit_lhs != bit_rhs) == (lhs != rhs));
+                assert((bit_lhs < bit_rhs) == (lhs < rhs) && (bit_lhs > bit_rhs) == (lhs > rhs));
+                assert((bit_lhs <= bit_rhs) == (lhs <= rhs) && (bit_lhs >= bit_rhs) == (lhs >= rhs));
+            }
+        }
+        std::cout << "Done!"s << std::endl << std::endl;
+    }
+
+
+    void ConstexprVector() {
+        using namespace std::string_literals;
+        std::cout << "Test constexpr vector"s << std::endl;
+        // Без поддержки C++20 те же функции проверяются только во время выполнения
+        assert(detail::ConstexprConstruction());
+        assert(detail::ConstexprPushBack());
+        assert(detail::ConstexprInsert());
+        assert(detail::ConstexprErase());
+        assert(detail::ConstexprResize());
+        assert(detail::ConstexprCompare());
+        assert(detail::BuildSquares().GetSize() == 9 && detail::BuildSquares()[7] == 64);
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+        static_assert(detail::ConstexprConstruction());
+        static_assert(detail::ConstexprPushBack());
+        static_assert(detail::ConstexprInsert());
+        static_assert(detail::ConstexprErase());
+        static_assert(detail::ConstexprResize());
+        static_assert(detail::ConstexprCompare());
 
-        auto it = v.Erase(v.begin());
-        assert(it->GetX() == 1);
+        static constexpr auto kSquares = FreezeSimpleVector<detail::BuildSquares>();
+        static_assert(kSquares.size() == 9 && kSquares[3] == 9 && kSquares[7] == 64);
+        const SimpleVector<int> squares = detail::BuildSquares();
+        assert(std::equal(kSquares.begin(), kSquares.end(), squares.begin(), squares.end()));
+#endif
         std::cout << "Done!"s << std::endl << std::endl;
     }
 
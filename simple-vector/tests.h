@@ -1,6 +1,21 @@
 #pragma once
 
+#include "bit_vector.h"
+#include "concurrent_simple_vector.h"
+#include "cow_simple_vector.h"
+#include "flat_map.h"
+#include "mapped_simple_vector.h"
+#include "mmap_allocator.h"
+#include "segmented_vector.h"
+#include "serialization.h"
 #include "simple_vector.h"
+#include "simple_vector_view.h"
+#include "small_simple_vector.h"
+#include "soa_vector.h"
+#include "sorted_simple_vector.h"
+
+#include <memory>
+#include <type_traits>
 
 namespace tests {
 
@@ -25,7 +40,22 @@ namespace tests {
             size_t x_;
         };
 
-        SimpleVector<int> GenerateVector(size_t size);
+        // Тип с нетривиальным перемещением, объявленный тривиально перемещаемым
+        class Relocatable {
+        public:
+            explicit Relocatable(int value);
+
+            Relocatable(Relocatable&& other) noexcept;
+
+            Relocatable& operator=(Relocatable&& other) noexcept;
+
+            int GetValue() const;
+
+            static inline int moves = 0;
+
+        private:
+            std::unique_ptr<int> value_;
+        };
 
     }
 
@@ -43,6 +73,12 @@ namespace tests {
 
     void Resize();
 
+    void TriviallyRelocatable();
+
+    void Reserve();
+
+    void NonDefaultConstructible();
+
     void Iterate();
 
     void PushBack();
@@ -53,14 +89,58 @@ namespace tests {
 
     void Compare();
 
+    void CompareKernels();
+
     void Swap();
 
     void CopyAssignment();
     
     void Insert();
 
+    void Emplace();
+
+    void RangeInsert();
+
     void Erase();
 
+    void EraseRange();
+
+    void ShrinkToFit();
+
+    void GrowthPolicy();
+
+    void MmapStorage();
+
+    void ParallelConstruction();
+
+    void ThrowingMoveInsert();
+
+    void ConcurrentPushBack();
+
+    void SegmentedVectorStableAddresses();
+
+    void CopyOnWrite();
+
+    void MappedFile();
+
+    void Serialization();
+
+    void View();
+
+    void StructureOfArrays();
+
+    void AlignedStorage();
+
+    void Instrumentation();
+
+    void OverwriteGrowth();
+
+    void SortedContainers();
+
+    void BitVectorBasics();
+
+    void ConstexprVector();
+
     void MoveConstructor();
 
     void MoveAssignment();
@@ -73,4 +153,27 @@ namespace tests {
 
     void NoncopiableErase(); 
 
+    void PmrResource();
+
+    void AllocatorPropagation();
+
+    void SmallVectorInline();
+
+    void SmallVectorSwapAndMove();
+
 }
+
+template <>
+struct IsTriviallyRelocatable<tests::detail::Relocatable> : std::true_type {
+};
+
+template <>
+struct SerializeTraits<tests::detail::X> {
+    static void Write(BinaryWriter& writer, const tests::detail::X& value) {
+        writer.Write<uint64_t>(value.GetX());
+    }
+
+    static tests::detail::X Read(BinaryReader& reader) {
+        return tests::detail::X(reader.Read<uint64_t>());
+    }
+};